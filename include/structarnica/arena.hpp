@@ -0,0 +1,222 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace DS {
+
+//bump allocator: memory is carved from large chunks
+//single allocations are never freed, everything goes away at once
+//reset() keeps chunks for reuse, release() returns them to the system
+class Arena {
+
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+public:
+
+    explicit Arena(size_t chunk_size = 1 << 16):m_chunk_size{chunk_size} {}
+
+    Arena(const Arena&) = delete;
+
+    Arena(Arena&& other) noexcept:m_chunk_size{other.m_chunk_size} {
+        swap(other);
+    }
+
+    Arena& operator=(const Arena&) = delete;
+
+    Arena& operator=(Arena&& other) noexcept {
+        release();
+        swap(other);
+        return *this;
+    }
+
+    ~Arena() { release(); }
+
+    void swap(Arena& other) noexcept {
+        std::swap(m_chunks, other.m_chunks);
+        std::swap(m_spare, other.m_spare);
+        std::swap(m_ptr, other.m_ptr);
+        std::swap(m_end, other.m_end);
+        std::swap(m_chunk_size, other.m_chunk_size);
+    }
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        char* p = _align(m_ptr, align);
+
+        //aligning may step past the end of chunk
+        if (!m_ptr || p > m_end || bytes > static_cast<size_t>(m_end - p)){
+            _next_chunk(bytes + align);
+            p = _align(m_ptr, align);
+        }
+
+        m_ptr = p + bytes;
+        return p;
+    }
+
+    //forget all allocations, chunks stay for next round
+    void reset() {
+        for (Chunk* c = m_chunks; c;){
+            Chunk* next = c->next;
+            c->next = m_spare;
+            m_spare = c;
+            c = next;
+        }
+
+        m_chunks = nullptr;
+        m_ptr = m_end = nullptr;
+    }
+
+    void release() {
+        reset();
+
+        for (Chunk* c = m_spare; c;){
+            Chunk* next = c->next;
+            ::operator delete(c);
+            c = next;
+        }
+
+        m_spare = nullptr;
+    }
+
+    //chunks owned by arena, used and spare
+    size_t chunks() const {
+        size_t res = 0;
+        for (Chunk* c = m_chunks; c; c = c->next, res++);
+        for (Chunk* c = m_spare; c; c = c->next, res++);
+        return res;
+    }
+
+private:
+
+    static char* _align(char* p, size_t align) {
+        auto addr = reinterpret_cast<uintptr_t>(p);
+        return p + ((align - addr % align) % align);
+    }
+
+    void _next_chunk(size_t need) {
+        Chunk* c = m_spare;
+
+        if (c && c->size >= need){
+            m_spare = c->next;
+        } else {
+            size_t size = std::max(m_chunk_size, need);
+            c = static_cast<Chunk*>(::operator new(sizeof(Chunk) + size));
+            c->size = size;
+        }
+
+        c->next = m_chunks;
+        m_chunks = c;
+        m_ptr = reinterpret_cast<char*>(c + 1);
+        m_end = m_ptr + c->size;
+    }
+
+    Chunk* m_chunks{nullptr};
+    Chunk* m_spare{nullptr};
+    char* m_ptr{nullptr};
+    char* m_end{nullptr};
+    size_t m_chunk_size;
+
+};
+
+//node allocation policies for node based containers
+//bulk_release = true means reset() frees every node at once
+
+//every node is a separate heap allocation
+struct HeapNodes {
+
+    static constexpr bool bulk_release = false;
+
+    void* allocate(size_t bytes, size_t align) {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t{align});
+        return ::operator new(bytes);
+    }
+
+    void deallocate(void* ptr, size_t, size_t align) {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(ptr, std::align_val_t{align});
+        else ::operator delete(ptr);
+    }
+
+    void reset() {}
+
+    void swap(HeapNodes&) {}
+};
+
+//nodes are carved from an arena, freed nodes are kept in free lists
+//by size and reused by following allocations
+class ArenaNodes {
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct FreeList {
+        size_t bytes;
+        FreeNode* head;
+    };
+
+public:
+
+    static constexpr bool bulk_release = true;
+
+    explicit ArenaNodes(size_t chunk_size = 1 << 16):m_arena(chunk_size) {}
+
+    void* allocate(size_t bytes, size_t align) {
+        for (auto& list : m_free){
+            if (list.bytes == bytes && list.head){
+                FreeNode* n = list.head;
+                list.head = n->next;
+                return n;
+            }
+        }
+
+        return m_arena.allocate(std::max(bytes, sizeof(FreeNode)), align);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t) {
+        FreeNode* n = static_cast<FreeNode*>(ptr);
+
+        for (auto& list : m_free){
+            if (list.bytes == bytes){
+                n->next = list.head;
+                list.head = n;
+                return;
+            }
+        }
+
+        n->next = nullptr;
+        m_free.push_back({bytes, n});
+    }
+
+    void reset() {
+        m_arena.reset();
+        for (auto& list : m_free)
+            list.head = nullptr;
+    }
+
+    void swap(ArenaNodes& other) {
+        m_arena.swap(other.m_arena);
+        m_free.swap(other.m_free);
+    }
+
+    const Arena& arena() const { return m_arena; }
+
+private:
+
+    Arena m_arena;
+    std::vector<FreeList> m_free;
+
+};
+
+} //DS namespace
+
+#endif //ARENA_HPP
@@ -0,0 +1,612 @@
+#ifndef BPLUS_TREE_HPP
+#define BPLUS_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DS {
+
+//ordered map in B+ tree: values live in leaves, inner nodes hold only
+//separators, leaves are chained for range scans
+//node capacities are taken from NodeBytes, so node of 64/128/256 bytes
+//is one to four cache lines and height is log_B(n), not log2(n)
+//arithmetic keys with std::less are searched in node by counting smaller
+//keys in a loop without branches, which compilers turn into SIMD compares
+//keys and values are stored in arrays, both must be default constructible
+template<typename K, typename V, typename Compare = std::less<K>, size_t NodeBytes = 256>
+class BPlusTree {
+
+    struct NodeBase {
+        unsigned _size{0};
+        bool _leaf;
+    };
+
+    //nodes start on cache line when NodeBytes is made of whole lines
+    static constexpr size_t _line = NodeBytes % 64 ? alignof(void*) : 64;
+
+    //arrays have one spare slot, node overflows first and then splits
+    template<size_t N>
+    struct alignas(_line) LeafOf : NodeBase {
+        LeafOf() { this->_leaf = true; }
+
+        K _keys[N + 1];
+        V _vals[N + 1];
+        LeafOf* _next{nullptr};
+    };
+
+    //_size is number of children, child i holds keys in [_keys[i - 1], _keys[i])
+    template<size_t N>
+    struct alignas(_line) InnerOf : NodeBase {
+        InnerOf() { this->_leaf = false; }
+
+        K _keys[N];
+        NodeBase* _child[N + 1];
+    };
+
+    //largest capacity whose node with header, spare slot and padding
+    //still fits into NodeBytes, but not below 4
+    template<template<size_t> typename Layout, size_t N>
+    static constexpr size_t _fit() {
+        if constexpr (N <= 4 || sizeof(Layout<N>) <= NodeBytes)
+            return N;
+        else return _fit<Layout, N - 1>();
+    }
+
+public:
+
+    //most key/value pairs in a leaf and most children of inner node
+    static constexpr size_t LeafCapacity = _fit<LeafOf, std::max<size_t>(4, NodeBytes / (sizeof(K) + sizeof(V)))>();
+    static constexpr size_t InnerCapacity = _fit<InnerOf, std::max<size_t>(4, NodeBytes / (sizeof(K) + sizeof(void*)))>();
+
+private:
+
+    using Leaf = LeafOf<LeafCapacity>;
+    using Inner = InnerOf<InnerCapacity>;
+
+    static_assert(sizeof(Leaf) <= NodeBytes && sizeof(Inner) <= NodeBytes,
+        "BPlusTree: NodeBytes is too small for 4 keys per node");
+
+public:
+
+    //real node sizes, at most NodeBytes
+    static constexpr size_t LeafBytes = sizeof(Leaf);
+    static constexpr size_t InnerBytes = sizeof(Inner);
+
+private:
+
+    //right half made by split and its first key
+    struct Split {
+        NodeBase* node{nullptr};
+        K key{};
+    };
+
+    static constexpr size_t _min_leaf = LeafCapacity / 2;
+    static constexpr size_t _min_inner = InnerCapacity / 2;
+
+    static constexpr bool _simd = std::is_arithmetic_v<K> &&
+        (std::is_same_v<Compare, std::less<K>> || std::is_same_v<Compare, std::less<>>);
+
+    NodeBase* m_root;
+    Leaf* m_first;
+    size_t m_size{0};
+    size_t m_height{1};
+    //const lookups call it, comparator may have non-const operator()
+    mutable Compare m_comp;
+
+    static Leaf* _as_leaf(NodeBase* n) { return static_cast<Leaf*>(n); }
+
+    static Inner* _as_inner(NodeBase* n) { return static_cast<Inner*>(n); }
+
+    //number of keys less than key, with upper also equal ones
+    template<bool Upper>
+    size_t _rank_in(const K* keys, size_t cnt, const K& key) const {
+        if constexpr (_simd){
+            size_t res = 0;
+            for (size_t i = 0; i < cnt; i++)
+                res += Upper ? keys[i] <= key : keys[i] < key;
+            return res;
+        } else if constexpr (Upper){
+            return std::upper_bound(keys, keys + cnt, key, m_comp) - keys;
+        } else return std::lower_bound(keys, keys + cnt, key, m_comp) - keys;
+    }
+
+    //child of inner node where key belongs
+    size_t _child_of(Inner* n, const K& key) const {
+        return _rank_in<true>(n->_keys, n->_size - 1, key);
+    }
+
+    Leaf* _leaf_of(const K& key) const {
+        NodeBase* n = m_root;
+        for (;!n->_leaf; n = _as_inner(n)->_child[_child_of(_as_inner(n), key)]);
+        return _as_leaf(n);
+    }
+
+    bool _equal(const K& a, const K& b) const {
+        return !m_comp(a, b) && !m_comp(b, a);
+    }
+
+    static void _free(NodeBase* n) {
+        if (n->_leaf){
+            delete _as_leaf(n);
+            return;
+        }
+
+        Inner* in = _as_inner(n);
+        for (size_t i = 0; i < in->_size; i++)
+            _free(in->_child[i]);
+        delete in;
+    }
+
+    bool _insert(NodeBase* n, const K& key, const V& val, Split& out) {
+        if (n->_leaf){
+            Leaf* leaf = _as_leaf(n);
+            size_t pos = _rank_in<false>(leaf->_keys, leaf->_size, key);
+
+            if (pos < leaf->_size && _equal(leaf->_keys[pos], key))
+                return false;
+
+            std::move_backward(leaf->_keys + pos, leaf->_keys + leaf->_size, leaf->_keys + leaf->_size + 1);
+            std::move_backward(leaf->_vals + pos, leaf->_vals + leaf->_size, leaf->_vals + leaf->_size + 1);
+            leaf->_keys[pos] = key;
+            leaf->_vals[pos] = val;
+
+            if (++leaf->_size > LeafCapacity)
+                out = _split(leaf);
+            return true;
+        }
+
+        Inner* in = _as_inner(n);
+        size_t pos = _child_of(in, key);
+        Split child;
+
+        if (!_insert(in->_child[pos], key, val, child))
+            return false;
+
+        if (child.node){
+            std::move_backward(in->_keys + pos, in->_keys + in->_size - 1, in->_keys + in->_size);
+            std::move_backward(in->_child + pos + 1, in->_child + in->_size, in->_child + in->_size + 1);
+            in->_keys[pos] = std::move(child.key);
+            in->_child[pos + 1] = child.node;
+
+            if (++in->_size > InnerCapacity)
+                out = _split(in);
+        }
+
+        return true;
+    }
+
+    static Split _split(Leaf* leaf) {
+        Leaf* right = new Leaf();
+        size_t keep = leaf->_size / 2;
+
+        right->_size = leaf->_size - keep;
+        std::move(leaf->_keys + keep, leaf->_keys + leaf->_size, right->_keys);
+        std::move(leaf->_vals + keep, leaf->_vals + leaf->_size, right->_vals);
+        leaf->_size = keep;
+
+        right->_next = leaf->_next;
+        leaf->_next = right;
+        return {right, right->_keys[0]};
+    }
+
+    //middle separator goes up, it is in neither half
+    static Split _split(Inner* in) {
+        Inner* right = new Inner();
+        size_t keep = in->_size / 2;
+
+        right->_size = in->_size - keep;
+        std::move(in->_keys + keep, in->_keys + in->_size - 1, right->_keys);
+        std::move(in->_child + keep, in->_child + in->_size, right->_child);
+        in->_size = keep;
+
+        return {right, std::move(in->_keys[keep - 1])};
+    }
+
+    bool _erase(NodeBase* n, const K& key) {
+        if (n->_leaf){
+            Leaf* leaf = _as_leaf(n);
+            size_t pos = _rank_in<false>(leaf->_keys, leaf->_size, key);
+
+            if (pos == leaf->_size || !_equal(leaf->_keys[pos], key))
+                return false;
+
+            std::move(leaf->_keys + pos + 1, leaf->_keys + leaf->_size, leaf->_keys + pos);
+            std::move(leaf->_vals + pos + 1, leaf->_vals + leaf->_size, leaf->_vals + pos);
+            leaf->_size--;
+            return true;
+        }
+
+        Inner* in = _as_inner(n);
+        size_t pos = _child_of(in, key);
+
+        if (!_erase(in->_child[pos], key))
+            return false;
+
+        NodeBase* child = in->_child[pos];
+        if (child->_size < (child->_leaf ? _min_leaf : _min_inner))
+            _fix(in, pos);
+
+        return true;
+    }
+
+    //child pos of in is under minimum: borrow from a sibling or merge with it
+    void _fix(Inner* in, size_t pos) {
+        size_t least = in->_child[pos]->_leaf ? _min_leaf : _min_inner;
+
+        if (pos > 0 && in->_child[pos - 1]->_size > least){
+            _borrow_left(in, pos);
+            return;
+        }
+
+        if (pos + 1 < in->_size && in->_child[pos + 1]->_size > least){
+            _borrow_right(in, pos);
+            return;
+        }
+
+        _merge(in, pos > 0 ? pos - 1 : pos);
+    }
+
+    void _borrow_left(Inner* in, size_t pos) {
+        NodeBase* left = in->_child[pos - 1];
+        NodeBase* cur = in->_child[pos];
+
+        if (cur->_leaf){
+            Leaf* l = _as_leaf(left);
+            Leaf* c = _as_leaf(cur);
+
+            std::move_backward(c->_keys, c->_keys + c->_size, c->_keys + c->_size + 1);
+            std::move_backward(c->_vals, c->_vals + c->_size, c->_vals + c->_size + 1);
+            c->_keys[0] = std::move(l->_keys[l->_size - 1]);
+            c->_vals[0] = std::move(l->_vals[l->_size - 1]);
+            l->_size--;
+            c->_size++;
+
+            in->_keys[pos - 1] = c->_keys[0];
+            return;
+        }
+
+        Inner* l = _as_inner(left);
+        Inner* c = _as_inner(cur);
+
+        std::move_backward(c->_keys, c->_keys + c->_size - 1, c->_keys + c->_size);
+        std::move_backward(c->_child, c->_child + c->_size, c->_child + c->_size + 1);
+        c->_keys[0] = std::move(in->_keys[pos - 1]);
+        c->_child[0] = l->_child[l->_size - 1];
+        c->_size++;
+
+        in->_keys[pos - 1] = std::move(l->_keys[l->_size - 2]);
+        l->_size--;
+    }
+
+    void _borrow_right(Inner* in, size_t pos) {
+        NodeBase* cur = in->_child[pos];
+        NodeBase* right = in->_child[pos + 1];
+
+        if (cur->_leaf){
+            Leaf* c = _as_leaf(cur);
+            Leaf* r = _as_leaf(right);
+
+            c->_keys[c->_size] = std::move(r->_keys[0]);
+            c->_vals[c->_size] = std::move(r->_vals[0]);
+            c->_size++;
+
+            std::move(r->_keys + 1, r->_keys + r->_size, r->_keys);
+            std::move(r->_vals + 1, r->_vals + r->_size, r->_vals);
+            r->_size--;
+
+            in->_keys[pos] = r->_keys[0];
+            return;
+        }
+
+        Inner* c = _as_inner(cur);
+        Inner* r = _as_inner(right);
+
+        c->_keys[c->_size - 1] = std::move(in->_keys[pos]);
+        c->_child[c->_size] = r->_child[0];
+        c->_size++;
+
+        in->_keys[pos] = std::move(r->_keys[0]);
+        std::move(r->_keys + 1, r->_keys + r->_size - 1, r->_keys);
+        std::move(r->_child + 1, r->_child + r->_size, r->_child);
+        r->_size--;
+    }
+
+    //moves child pos + 1 into child pos and frees it
+    void _merge(Inner* in, size_t pos) {
+        NodeBase* left = in->_child[pos];
+        NodeBase* right = in->_child[pos + 1];
+
+        if (left->_leaf){
+            Leaf* l = _as_leaf(left);
+            Leaf* r = _as_leaf(right);
+
+            std::move(r->_keys, r->_keys + r->_size, l->_keys + l->_size);
+            std::move(r->_vals, r->_vals + r->_size, l->_vals + l->_size);
+            l->_size += r->_size;
+            l->_next = r->_next;
+            delete r;
+        } else {
+            Inner* l = _as_inner(left);
+            Inner* r = _as_inner(right);
+
+            l->_keys[l->_size - 1] = std::move(in->_keys[pos]);
+            std::move(r->_keys, r->_keys + r->_size - 1, l->_keys + l->_size);
+            std::move(r->_child, r->_child + r->_size, l->_child + l->_size);
+            l->_size += r->_size;
+            delete r;
+        }
+
+        std::move(in->_keys + pos + 1, in->_keys + in->_size - 1, in->_keys + pos);
+        std::move(in->_child + pos + 2, in->_child + in->_size, in->_child + pos + 1);
+        in->_size--;
+    }
+
+    //sizes of groups when cnt items are spread evenly over nodes of cap
+    static std::vector<size_t> _spread(size_t cnt, size_t cap) {
+        size_t groups = (cnt + cap - 1) / cap;
+        std::vector<size_t> res(groups, cnt / groups);
+
+        for (size_t i = 0; i < cnt % groups; i++)
+            res[i]++;
+
+        return res;
+    }
+
+public:
+
+    //forward iterator over leaf chain
+    struct Iterator {
+
+        Iterator() = default;
+
+        Iterator(Leaf* leaf, size_t pos):m_leaf{leaf}, m_pos{pos} {
+            _skip();
+        }
+
+        const K& key() const { return m_leaf->_keys[m_pos]; }
+
+        V& value() const { return m_leaf->_vals[m_pos]; }
+
+        Iterator& operator++() {
+            m_pos++;
+            _skip();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return m_leaf == other.m_leaf && m_pos == other.m_pos; }
+
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+        operator bool() const { return m_leaf; }
+
+    private:
+
+        //steps over the end of leaf, end() is null leaf
+        void _skip() {
+            for (;m_leaf && m_pos == m_leaf->_size; m_pos = 0)
+                m_leaf = m_leaf->_next;
+        }
+
+        Leaf* m_leaf{nullptr};
+        size_t m_pos{0};
+    };
+
+    using iterator = Iterator;
+
+    explicit BPlusTree(Compare comp = Compare()):m_comp{std::move(comp)} {
+        m_first = new Leaf();
+        m_root = m_first;
+    }
+
+    BPlusTree(const BPlusTree&) = delete;
+
+    BPlusTree(BPlusTree&& other):BPlusTree(other.m_comp) {
+        swap(other);
+    }
+
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    BPlusTree& operator=(BPlusTree&& other) {
+        swap(other);
+        return *this;
+    }
+
+    ~BPlusTree() { _free(m_root); }
+
+    void swap(BPlusTree& other) {
+        std::swap(m_root, other.m_root);
+        std::swap(m_first, other.m_first);
+        std::swap(m_size, other.m_size);
+        std::swap(m_height, other.m_height);
+        std::swap(m_comp, other.m_comp);
+    }
+
+    //builds tree from sorted range of key/value pairs in one pass
+    template<std::ranges::input_range R>
+    static BPlusTree from_sorted(R&& range, Compare comp = Compare()) {
+        BPlusTree res(std::move(comp));
+        res.assign_sorted(std::forward<R>(range));
+        return res;
+    }
+
+    //replaces content with sorted range of distinct keys, leaves are
+    //filled evenly and inner levels are built bottom up, no searching
+    //throws std::logic_error if keys are not sorted and distinct
+    template<std::ranges::input_range R>
+    void assign_sorted(R&& range) {
+        std::vector<std::pair<K, V>> items;
+        for (auto&& [key, val] : range){
+            if (!items.empty() && !m_comp(items.back().first, key))
+                throw std::logic_error("assign_sorted: keys are not sorted and distinct");
+            items.emplace_back(key, val);
+        }
+
+        clear();
+        if (items.empty())
+            return;
+
+        delete _as_leaf(m_root);
+
+        std::vector<NodeBase*> level;
+        std::vector<K> firsts;
+        Leaf* prev = nullptr;
+        size_t at = 0;
+
+        for (size_t cnt : _spread(items.size(), LeafCapacity)){
+            Leaf* leaf = new Leaf();
+            for (size_t i = 0; i < cnt; i++, at++){
+                leaf->_keys[i] = std::move(items[at].first);
+                leaf->_vals[i] = std::move(items[at].second);
+            }
+            leaf->_size = cnt;
+
+            if (prev)
+                prev->_next = leaf;
+            else m_first = leaf;
+
+            prev = leaf;
+            level.push_back(leaf);
+            firsts.push_back(leaf->_keys[0]);
+        }
+
+        m_size = items.size();
+        m_height = 1;
+
+        for (;level.size() > 1; m_height++){
+            std::vector<NodeBase*> up;
+            std::vector<K> up_firsts;
+            at = 0;
+
+            for (size_t cnt : _spread(level.size(), InnerCapacity)){
+                Inner* in = new Inner();
+                for (size_t i = 0; i < cnt; i++, at++){
+                    in->_child[i] = level[at];
+                    if (i)
+                        in->_keys[i - 1] = firsts[at];
+                }
+                in->_size = cnt;
+
+                up.push_back(in);
+                up_firsts.push_back(firsts[at - cnt]);
+            }
+
+            level.swap(up);
+            firsts.swap(up_firsts);
+        }
+
+        m_root = level[0];
+    }
+
+    //returns false if key is already present, value is not changed then
+    bool insert(const K& key, const V& val) {
+        Split split;
+
+        if (!_insert(m_root, key, val, split))
+            return false;
+
+        if (split.node){
+            Inner* root = new Inner();
+            root->_size = 2;
+            root->_keys[0] = std::move(split.key);
+            root->_child[0] = m_root;
+            root->_child[1] = split.node;
+            m_root = root;
+            m_height++;
+        }
+
+        m_size++;
+        return true;
+    }
+
+    //returns false if key is not present
+    bool erase(const K& key) {
+        if (!_erase(m_root, key))
+            return false;
+
+        if (!m_root->_leaf && m_root->_size == 1){
+            Inner* old = _as_inner(m_root);
+            m_root = old->_child[0];
+            delete old;
+            m_height--;
+        }
+
+        m_size--;
+        return true;
+    }
+
+    //value of key, nullptr if key is not present
+    V* find(const K& key) {
+        Leaf* leaf = _leaf_of(key);
+        size_t pos = _rank_in<false>(leaf->_keys, leaf->_size, key);
+
+        return pos < leaf->_size && _equal(leaf->_keys[pos], key) ? &leaf->_vals[pos] : nullptr;
+    }
+
+    bool contains(const K& key) { return find(key); }
+
+    //first element with key not less than key
+    iterator lower_bound(const K& key) {
+        Leaf* leaf = _leaf_of(key);
+        return iterator(leaf, _rank_in<false>(leaf->_keys, leaf->_size, key));
+    }
+
+    const K& min() {
+        if (!m_size)
+            throw std::out_of_range("min: tree is empty");
+        return m_first->_keys[0];
+    }
+
+    const K& max() {
+        if (!m_size)
+            throw std::out_of_range("max: tree is empty");
+
+        NodeBase* n = m_root;
+        for (;!n->_leaf; n = _as_inner(n)->_child[n->_size - 1]);
+        return _as_leaf(n)->_keys[n->_size - 1];
+    }
+
+    //calls func(key, value) in key order
+    template<typename F>
+    void inorder(F&& func) {
+        for (Leaf* leaf = m_first; leaf; leaf = leaf->_next){
+            for (size_t i = 0; i < leaf->_size; i++)
+                func(leaf->_keys[i], leaf->_vals[i]);
+        }
+    }
+
+    void clear() {
+        _free(m_root);
+        m_first = new Leaf();
+        m_root = m_first;
+        m_size = 0;
+        m_height = 1;
+    }
+
+    size_t size() const { return m_size; }
+
+    bool empty() const { return !m_size; }
+
+    //levels including leaves
+    size_t height() const { return m_height; }
+
+    iterator begin() { return iterator(m_first, 0); }
+    iterator end() { return iterator(); }
+
+};
+
+} //DS namespace
+
+#endif //BPLUS_TREE_HPP
@@ -2,16 +2,42 @@
 #define BST_HPP
 
 #include <cmath>
+#include <cstddef>
 #include <queue>
 #include <deque>
 #include <stack>
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <structarnica/frozen_bst.hpp>
 
 namespace DS {
 
-template<typename T, typename Compare = std::less<T> >
+//balancing policies of BST
+
+//shape follows insertion order, balance() rebuilds tree on demand
+struct Unbalanced {};
+
+//heights of sibling subtrees differ by one at most
+struct AVL {};
+
+//left leaning red-black tree (Sedgewick), red links lean left
+struct RedBlack {};
+
+//false for any policy, static_assert on it fires only when
+//a branch for unknown policy is instantiated
+template<typename Balance>
+inline constexpr bool unsupported_balance = false;
+
+//AVL and RedBlack keep height O(log n) on every insert and erase
+template<typename T, typename Compare = std::less<T>, typename Balance = Unbalanced>
 class BST {
 
+    static constexpr bool balanced = !std::is_same_v<Balance, Unbalanced>;
+
     struct Node {
 
         Node() = default;
@@ -20,12 +46,58 @@ class BST {
 
         T _data;
         unsigned _count{1};
+        //elements in subtree with copies, order statistics are taken from it
+        std::size_t _size{1};
         Node* _left{nullptr};
         Node* _right{nullptr};
+        //AVL: height of subtree, RedBlack: 1 if link from parent is red
+        unsigned char _bal{1};
     };
 
 public:
 
+    //owning handle of a node taken out by extract(), insert() links the
+    //same allocation into another tree, nothing is copied
+    //handle that was not inserted frees its node
+    struct NodeHandle {
+
+        NodeHandle() = default;
+
+        NodeHandle(const NodeHandle&) = delete;
+
+        NodeHandle(NodeHandle&& other):m_node{std::exchange(other.m_node, nullptr)} {}
+
+        NodeHandle& operator=(const NodeHandle&) = delete;
+
+        NodeHandle& operator=(NodeHandle&& other) {
+            std::swap(m_node, other.m_node);
+            return *this;
+        }
+
+        ~NodeHandle() { delete m_node; }
+
+        bool empty() const { return !m_node; }
+
+        operator bool() const { return m_node; }
+
+        //value may be changed while node is out of a tree
+        T& value() { return m_node->_data; }
+
+        //copies of the value the node stands for
+        unsigned count() const { return m_node->_count; }
+
+        friend BST;
+
+    private:
+
+        explicit NodeHandle(Node* ptr):m_node{ptr} {}
+
+        Node* m_node{nullptr};
+
+    };
+
+    using node_type = NodeHandle;
+
     BST() {}
 
     ~BST() { clear(); }
@@ -60,6 +132,8 @@ public:
 
             delete t;
         }
+
+        m_root = nullptr;
     }
 
     template<typename F>
@@ -85,11 +159,18 @@ public:
     }
 
     void insert(const T& val) {
+        if constexpr (balanced){
+            m_root = _insert(m_root, val, 1, [&val]{ return new Node(val); });
+            _paint_root();
+            return;
+        }
+
         Node* it = m_root;
         Node* prev = nullptr;
 
         for (;it;){
             prev = it;
+            it->_size++;
             if (it->_data == val){
                 it->_count++;
                 return;
@@ -193,6 +274,18 @@ public:
     }
 
     void erase(const T& val) {
+        if constexpr (balanced){
+            Node* n = _find(m_root, val);
+
+            if (n && n->_count > 1){
+                _path_add(val, -1);
+                n->_count--;
+                n->_size--;
+            } else if (n)
+                delete _remove(val);
+            return;
+        }
+
         Node* it = m_root;
         Node* prev = nullptr;
         for (;it;){
@@ -205,6 +298,8 @@ public:
         }
 
         if (it && val == it->_data){
+            _path_add(val, -1);
+
             if (it == m_root)
                 _erase_merge(m_root);
             else if (prev->_left == it)
@@ -213,11 +308,142 @@ public:
         }
     }
 
-    std::size_t transform_to_list() {
-        return _create_backbone(m_root);
+    //deletion by copying: node takes data of its predecessor, which is
+    //unlinked instead, tree grows in height slower than with merging
+    void erase_copy(const T& val) requires (!balanced) {
+        Node*& node = _slot(val);
+
+        if (node){
+            _path_add(val, -1);
+            _erase_copy(node);
+        }
     }
 
-    void balance() {
+    //unlinks node of val with all its copies and hands it over,
+    //empty handle if val is not present
+    NodeHandle extract(const T& val) {
+        if constexpr (balanced)
+            return NodeHandle(_find(m_root, val) ? _remove(val) : nullptr);
+
+        Node*& node = _slot(val);
+
+        if (!node)
+            return {};
+
+        _path_add(val, -static_cast<std::ptrdiff_t>(node->_count));
+        return NodeHandle(_detach(node));
+    }
+
+    //links node of the handle; if its value is already present only
+    //the copies are added and node is freed
+    void insert(NodeHandle&& nh) {
+        if (!nh)
+            return;
+
+        Node* n = std::exchange(nh.m_node, nullptr);
+
+        if constexpr (balanced){
+            bool linked = false;
+            m_root = _insert(m_root, n->_data, n->_count, [n, &linked]{
+                linked = true;
+                return _fresh(n);
+            });
+            _paint_root();
+
+            if (!linked)
+                delete n;
+            return;
+        }
+
+        Node*& node = _slot(n->_data);
+        _path_add(n->_data, n->_count);
+
+        if (node){
+            node->_count += n->_count;
+            node->_size += n->_count;
+            delete n;
+            return;
+        }
+
+        node = _fresh(n);
+    }
+
+    //moves every node of other here, other is left empty
+    void merge(BST& other) {
+        if (this == &other)
+            return;
+
+        std::stack<Node*> st;
+        if (other.m_root)
+            st.push(other.m_root);
+        other.m_root = nullptr;
+
+        for (Node* it; !st.empty();){
+            it = st.top();
+            st.pop();
+
+            if (it->_left)
+                st.push(it->_left);
+            if (it->_right)
+                st.push(it->_right);
+
+            insert(NodeHandle(it));
+        }
+    }
+
+    //immutable flat copy for read mostly phases, tree itself is kept
+    FrozenBST<T, Compare> freeze() {
+        std::vector<T> keys;
+        std::vector<unsigned> counts;
+        std::stack<Node*> st;
+
+        for (Node* it = m_root; it || !st.empty();){
+            for (;it; it = it->_left)
+                st.push(it);
+
+            it = st.top();
+            st.pop();
+
+            keys.push_back(it->_data);
+            counts.push_back(it->_count);
+            it = it->_right;
+        }
+
+        return FrozenBST<T, Compare>(keys, counts, comp);
+    }
+
+    //number of levels, 0 for empty tree
+    std::size_t height() {
+        std::size_t res = 0;
+        std::deque<Node*> q;
+
+        if (m_root)
+            q.push_back(m_root);
+
+        for (;!q.empty(); res++){
+            for (std::size_t i = q.size(); i > 0; i--){
+                Node* it = q.front();
+                q.pop_front();
+
+                if (it->_left)
+                    q.push_back(it->_left);
+                if (it->_right)
+                    q.push_back(it->_right);
+            }
+        }
+
+        return res;
+    }
+
+    //shape changing operations below would break invariants of a balancing policy
+
+    std::size_t transform_to_list() requires (!balanced) {
+        std::size_t len = _create_backbone(m_root);
+        _recount_all();
+        return len;
+    }
+
+    void balance() requires (!balanced) {
         Node* tmp = new Node();
 
         tmp->_right = m_root;
@@ -235,10 +461,110 @@ public:
         m_root = tmp->_right;
 
         delete tmp;
+
+        _recount_all();
+    }
+
+    //elements with copies
+    std::size_t size() const { return _weight(m_root); }
+
+    bool empty() const { return !m_root; }
+
+    //number of elements less than val, copies included
+    std::size_t rank(const T& val) {
+        std::size_t res = 0;
+
+        for (Node* it = m_root; it;){
+            if (val == it->_data)
+                return res + _weight(it->_left);
+
+            if (comp(val, it->_data)){
+                it = it->_left;
+            } else {
+                res += _weight(it->_left) + it->_count;
+                it = it->_right;
+            }
+        }
+
+        return res;
     }
 
+    //k-th smallest element counting from 0, copies included
+    const T& select(std::size_t k) {
+        if (k >= size())
+            throw std::out_of_range("select: position is out of range");
+
+        Node* it = m_root;
+        for (;;){
+            std::size_t left = _weight(it->_left);
+
+            if (k < left){
+                it = it->_left;
+            } else if (k < left + it->_count){
+                return it->_data;
+            } else {
+                k -= left + it->_count;
+                it = it->_right;
+            }
+        }
+    }
+
+    //number of elements in [lo, hi)
+    std::size_t count_range(const T& lo, const T& hi) {
+        std::size_t a = rank(lo);
+        std::size_t b = rank(hi);
+        return b > a ? b - a : 0;
+    }
+
+#ifdef DS_DEBUG_BST
+
+    //checks order, subtree sizes and invariant of the balancing policy
+    //in every node, O(n), made for tests
+    bool valid() {
+        if constexpr (std::is_same_v<Balance, RedBlack>){
+            if (_red(m_root))
+                return false;
+        }
+
+        return _valid(m_root, nullptr, nullptr) >= 0;
+    }
+
+#endif
+
 private:
 
+#ifdef DS_DEBUG_BST
+
+    //height of subtree, black height for RedBlack, -1 if subtree is broken
+    int _valid(Node* n, const T* lo, const T* hi) {
+        if (!n)
+            return 0;
+
+        if ((lo && !comp(*lo, n->_data)) || (hi && !comp(n->_data, *hi)))
+            return -1;
+        if (!n->_count || n->_size != n->_count + _weight(n->_left) + _weight(n->_right))
+            return -1;
+
+        int l = _valid(n->_left, lo, &n->_data);
+        int r = _valid(n->_right, &n->_data, hi);
+        if (l < 0 || r < 0)
+            return -1;
+
+        if constexpr (std::is_same_v<Balance, AVL>){
+            if (l - r > 1 || r - l > 1 || n->_bal != 1 + std::max(l, r))
+                return -1;
+        } else if constexpr (std::is_same_v<Balance, RedBlack>){
+            //reds lean left and never follow each other
+            if (_red(n->_right) || (_red(n) && _red(n->_left)) || l != r)
+                return -1;
+            return l + !_red(n);
+        }
+
+        return 1 + std::max(l, r);
+    }
+
+#endif
+
     void _compress(Node* grand, std::size_t m){
         Node* tmp = grand->_right;
         Node* prev;
@@ -324,6 +650,7 @@ private:
 
         if (node->_count > 1){
             node->_count--;
+            node->_size--;
             return;
         }
 
@@ -343,11 +670,17 @@ private:
                 it = it->_right;
             }
 
+            //copies of predecessor move up to node
+            for (Node* p = node->_left; p != it; p = p->_right)
+                p->_size -= it->_count;
+            node->_size--;
+
             node->_data = it->_data;
             node->_count = it->_count;
+            //predecessor has no right child, its left one takes its place
             if (prev == node)
                 prev->_left = it->_left;
-            else prev->_right = it->_right;
+            else prev->_right = it->_left;
         }
 
         delete it;
@@ -359,9 +692,15 @@ private:
 
         if (node->_count > 1){
             node->_count--;
+            node->_size--;
             return;
         }
 
+        delete _detach(node);
+    }
+
+    //unlinks node by merging, returns it
+    Node* _detach(Node*& node) {
         Node* prev = node;
 
         if (!node->_right){
@@ -369,8 +708,12 @@ private:
         } else if (!node->_left){
             node = node->_right;
         } else {
-            prev = node->_left;
-            for (; prev->_right; prev = prev->_right);
+            //right subtree is added to every node of the path it hangs from
+            for (prev = node->_left;; prev = prev->_right){
+                prev->_size += node->_right->_size;
+                if (!prev->_right)
+                    break;
+            }
 
             prev->_right = node->_right;
 
@@ -378,10 +721,51 @@ private:
             node = node->_left;
         }
 
-        delete prev;
+        return prev;
     }
 
-    Node* _find(Node* root, const T& val) const {
+    static std::size_t _weight(Node* n) { return n ? n->_size : 0; }
+
+    static void _recount(Node* n) {
+        n->_size = n->_count + _weight(n->_left) + _weight(n->_right);
+    }
+
+    //adds d to sizes of nodes above node of val, or above place where it belongs
+    void _path_add(const T& val, std::ptrdiff_t d) {
+        for (Node* it = m_root; it && !(it->_data == val);){
+            it->_size += d;
+            it = comp(val, it->_data) ? it->_left : it->_right;
+        }
+    }
+
+    //sizes of whole tree from scratch, children before parents
+    void _recount_all() {
+        std::vector<Node*> order;
+        if (m_root)
+            order.push_back(m_root);
+
+        for (std::size_t i = 0; i < order.size(); i++){
+            if (order[i]->_left)
+                order.push_back(order[i]->_left);
+            if (order[i]->_right)
+                order.push_back(order[i]->_right);
+        }
+
+        for (auto it = order.rbegin(); it != order.rend(); ++it)
+            _recount(*it);
+    }
+
+    //link that points to node of val, or empty link where val belongs
+    Node*& _slot(const T& val) {
+        Node** it = &m_root;
+
+        for (;*it && !((*it)->_data == val);)
+            it = comp(val, (*it)->_data) ? &(*it)->_left : &(*it)->_right;
+
+        return *it;
+    }
+
+    Node* _find(Node* root, const T& val) {
         for (;root;){
             if (val == root->_data)
                 return root;
@@ -393,6 +777,251 @@ private:
         return nullptr;
     }
 
+    //node out of a tree made ready to be linked as a leaf
+    static Node* _fresh(Node* n) {
+        n->_left = n->_right = nullptr;
+        n->_size = n->_count;
+        n->_bal = 1;
+        return n;
+    }
+
+    static int _height(Node* n) { return n ? n->_bal : 0; }
+
+    static bool _red(Node* n) { return n && n->_bal; }
+
+    static void _update(Node* n) {
+        n->_bal = 1 + std::max(_height(n->_left), _height(n->_right));
+    }
+
+    //rotations of balanced trees, return new root of the subtree
+    static Node* _rotate_left(Node* n) {
+        Node* x = n->_right;
+        n->_right = x->_left;
+        x->_left = n;
+
+        _recount(n);
+        _recount(x);
+
+        if constexpr (std::is_same_v<Balance, AVL>){
+            _update(n);
+            _update(x);
+        } else if constexpr (std::is_same_v<Balance, RedBlack>){
+            x->_bal = n->_bal;
+            n->_bal = 1;
+        } else {
+            static_assert(unsupported_balance<Balance>, "BST: Balance must be Unbalanced, AVL or RedBlack");
+        }
+
+        return x;
+    }
+
+    static Node* _rotate_right(Node* n) {
+        Node* x = n->_left;
+        n->_left = x->_right;
+        x->_right = n;
+
+        _recount(n);
+        _recount(x);
+
+        if constexpr (std::is_same_v<Balance, AVL>){
+            _update(n);
+            _update(x);
+        } else if constexpr (std::is_same_v<Balance, RedBlack>){
+            x->_bal = n->_bal;
+            n->_bal = 1;
+        } else {
+            static_assert(unsupported_balance<Balance>, "BST: Balance must be Unbalanced, AVL or RedBlack");
+        }
+
+        return x;
+    }
+
+    static void _flip(Node* n) {
+        n->_bal ^= 1;
+        n->_left->_bal ^= 1;
+        n->_right->_bal ^= 1;
+    }
+
+    //restores invariant of the policy at n, children already satisfy it
+    static Node* _fix(Node* n) {
+        _recount(n);
+
+        if constexpr (std::is_same_v<Balance, AVL>){
+            _update(n);
+            int diff = _height(n->_left) - _height(n->_right);
+
+            if (diff > 1){
+                if (_height(n->_left->_left) < _height(n->_left->_right))
+                    n->_left = _rotate_left(n->_left);
+                n = _rotate_right(n);
+            } else if (diff < -1){
+                if (_height(n->_right->_right) < _height(n->_right->_left))
+                    n->_right = _rotate_right(n->_right);
+                n = _rotate_left(n);
+            }
+        } else if constexpr (std::is_same_v<Balance, RedBlack>){
+            if (_red(n->_right) && !_red(n->_left))
+                n = _rotate_left(n);
+            if (_red(n->_left) && _red(n->_left->_left))
+                n = _rotate_right(n);
+            if (_red(n->_left) && _red(n->_right))
+                _flip(n);
+        } else {
+            static_assert(unsupported_balance<Balance>, "BST: Balance must be Unbalanced, AVL or RedBlack");
+        }
+
+        return n;
+    }
+
+    //root of red-black tree is black
+    void _paint_root() {
+        if constexpr (std::is_same_v<Balance, RedBlack>){
+            if (m_root)
+                m_root->_bal = 0;
+        }
+    }
+
+    //adds cnt copies to node of val, or links make() when val is absent
+    template<typename Make>
+    Node* _insert(Node* root, const T& val, unsigned cnt, Make&& make) {
+        if (!root)
+            return make();
+
+        if (val == root->_data){
+            root->_count += cnt;
+            root->_size += cnt;
+            return root;
+        }
+
+        if (comp(val, root->_data))
+            root->_left = _insert(root->_left, val, cnt, make);
+        else root->_right = _insert(root->_right, val, cnt, make);
+
+        return _fix(root);
+    }
+
+    //unlinks node of val from balanced tree and returns it, val must be present
+    Node* _remove(const T& val) {
+        Node* res = nullptr;
+
+        if constexpr (std::is_same_v<Balance, AVL>){
+            m_root = _avl_erase(m_root, val, res);
+        } else if constexpr (std::is_same_v<Balance, RedBlack>){
+            if (!_red(m_root->_left) && !_red(m_root->_right))
+                m_root->_bal = 1;
+
+            m_root = _rb_erase(m_root, val, res);
+            _paint_root();
+        } else {
+            static_assert(unsupported_balance<Balance>, "BST: Balance must be Unbalanced, AVL or RedBlack");
+        }
+
+        return res;
+    }
+
+    //out gets the smallest node of the subtree
+    Node* _avl_erase_min(Node* root, Node*& out) {
+        if (!root->_left){
+            out = root;
+            return root->_right;
+        }
+
+        root->_left = _avl_erase_min(root->_left, out);
+        return _fix(root);
+    }
+
+    //node of val is replaced with its successor, nodes are relinked, not copied
+    Node* _avl_erase(Node* root, const T& val, Node*& out) {
+        if (val == root->_data){
+            out = root;
+
+            if (!root->_left || !root->_right)
+                return root->_left ? root->_left : root->_right;
+
+            Node* next = nullptr;
+            Node* right = _avl_erase_min(root->_right, next);
+            next->_left = root->_left;
+            next->_right = right;
+            return _fix(next);
+        }
+
+        if (comp(val, root->_data))
+            root->_left = _avl_erase(root->_left, val, out);
+        else root->_right = _avl_erase(root->_right, val, out);
+
+        return _fix(root);
+    }
+
+    //red link is pushed down the path, so removed node is never a black leaf
+    Node* _move_red_left(Node* n) {
+        _flip(n);
+
+        if (_red(n->_right->_left)){
+            n->_right = _rotate_right(n->_right);
+            n = _rotate_left(n);
+            _flip(n);
+        }
+
+        return n;
+    }
+
+    Node* _move_red_right(Node* n) {
+        _flip(n);
+
+        if (_red(n->_left->_left)){
+            n = _rotate_right(n);
+            _flip(n);
+        }
+
+        return n;
+    }
+
+    Node* _rb_erase_min(Node* root, Node*& out) {
+        if (!root->_left){
+            out = root;
+            return nullptr;
+        }
+
+        if (!_red(root->_left) && !_red(root->_left->_left))
+            root = _move_red_left(root);
+
+        root->_left = _rb_erase_min(root->_left, out);
+        return _fix(root);
+    }
+
+    Node* _rb_erase(Node* root, const T& val, Node*& out) {
+        if (comp(val, root->_data)){
+            if (!_red(root->_left) && !_red(root->_left->_left))
+                root = _move_red_left(root);
+
+            root->_left = _rb_erase(root->_left, val, out);
+            return _fix(root);
+        }
+
+        if (_red(root->_left))
+            root = _rotate_right(root);
+
+        if (val == root->_data && !root->_right){
+            out = root;
+            return nullptr;
+        }
+
+        if (!_red(root->_right) && !_red(root->_right->_left))
+            root = _move_red_right(root);
+
+        if (val == root->_data){
+            Node* next = nullptr;
+            Node* right = _rb_erase_min(root->_right, next);
+            next->_left = root->_left;
+            next->_right = right;
+            next->_bal = root->_bal;
+            out = root;
+            root = next;
+        } else root->_right = _rb_erase(root->_right, val, out);
+
+        return _fix(root);
+    }
+
     template<typename F>
     void _preorder(Node* root, F&& func) {
         if (root){
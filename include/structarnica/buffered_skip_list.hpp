@@ -0,0 +1,128 @@
+#ifndef BUFFERED_SKIP_LIST_HPP
+#define BUFFERED_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <structarnica/skip_list.hpp>
+
+namespace DS {
+
+//write combining front-end of SkipList
+//inserts are collected in small unsorted buffer; when it fills up it is
+//sorted and handed to SkipList::insert_sorted, where every search starts
+//from the finger left by the previous element
+//point lookups check the buffer too, ordered reads (iteration, bounds)
+//flush it first; like SkipList itself it is not thread safe, threads
+//that ingest into their own shards get a buffer each
+template<typename T, typename Compare = std::less<>>
+class BufferedSkipList {
+
+public:
+
+    using iterator = typename SkipList<T, Compare>::iterator;
+
+    explicit BufferedSkipList(size_t capacity = 64, size_t max_levels = SkipList<T, Compare>::MaxLevels, Compare comp = Compare()):
+        m_list(max_levels, 0.5, HeapNodes(), comp),
+        m_capacity{std::max<size_t>(capacity, 1)},
+        m_comp{comp}
+    {
+        m_buffer.reserve(m_capacity);
+    }
+
+    void insert(const T& val) {
+        m_buffer.push_back(val);
+
+        if (m_buffer.size() == m_capacity)
+            flush();
+    }
+
+    //moves buffered elements to the list
+    void flush() {
+        if (m_buffer.empty())
+            return;
+
+        std::sort(m_buffer.begin(), m_buffer.end(), m_comp);
+        m_list.insert_sorted(m_buffer);
+        m_buffer.clear();
+    }
+
+    //removes one element equal to val, buffer is checked first
+    void remove(const T& val) {
+        auto it = _buffered(val);
+
+        if (it == m_buffer.end()){
+            m_list.remove(val);
+            return;
+        }
+
+        *it = std::move(m_buffer.back());
+        m_buffer.pop_back();
+    }
+
+    template<typename K = T>
+    bool contains(const K& key) {
+        return _buffered(key) != m_buffer.end() || m_list.contains(key);
+    }
+
+    template<typename K = T>
+    iterator find(const K& key) {
+        flush();
+        return m_list.find(key);
+    }
+
+    template<typename K = T>
+    iterator lower_bound(const K& key) {
+        flush();
+        return m_list.lower_bound(key);
+    }
+
+    template<typename K = T>
+    iterator upper_bound(const K& key) {
+        flush();
+        return m_list.upper_bound(key);
+    }
+
+    void clear() {
+        m_buffer.clear();
+        m_list.clear();
+    }
+
+    bool empty() const { return m_buffer.empty() && m_list.empty(); }
+
+    size_t size() const { return m_buffer.size() + m_list.size(); }
+
+    size_t buffered() const { return m_buffer.size(); }
+
+    //list behind the buffer, flushed
+    SkipList<T, Compare>& list() {
+        flush();
+        return m_list;
+    }
+
+    iterator begin() {
+        flush();
+        return m_list.begin();
+    }
+
+    iterator end() { return m_list.end(); }
+
+private:
+
+    template<typename K>
+    typename std::vector<T>::iterator _buffered(const K& key) {
+        return std::find_if(m_buffer.begin(), m_buffer.end(), [this, &key](const T& val){
+            return !m_comp(val, key) && !m_comp(key, val);
+        });
+    }
+
+    SkipList<T, Compare> m_list;
+    std::vector<T> m_buffer;
+    size_t m_capacity;
+    Compare m_comp;
+
+};
+
+} //DS namespace
+
+#endif //BUFFERED_SKIP_LIST_HPP
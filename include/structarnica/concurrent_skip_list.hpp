@@ -0,0 +1,288 @@
+#ifndef CONCURRENT_SKIP_LIST_HPP
+#define CONCURRENT_SKIP_LIST_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <random>
+#include <thread>
+#include <functional>
+#include <structarnica/epoch.hpp>
+#include <structarnica/striped_counter.hpp>
+
+namespace DS {
+
+//lock-free skip list (Fraser / Herlihy-Shavit)
+//set semantics: every key is stored at most once
+//a node is removed logically by setting the low bit of its forward pointers
+//top to bottom, mark on level 0 decides which erase wins
+//physically unlinked nodes are reclaimed through DS::Epoch
+template<typename T>
+class ConcurrentSkipList {
+
+public:
+
+    static constexpr size_t MaxLevels = 32;
+
+private:
+
+    using Link = std::atomic<uintptr_t>;
+
+    struct Node {
+
+        Node(const T& val, size_t height):_data{val}, _height{height} {}
+
+        Link* _links() { return reinterpret_cast<Link*>(this + 1); }
+
+        Link& _link(size_t lvl) { return _links()[lvl]; }
+
+        T _data;
+        size_t _height;
+        //inserting thread and erasing thread both drop one reference
+        //when they are done touching the links, the last one retires the node
+        std::atomic<int> _refs{2};
+    };
+
+    static_assert(sizeof(Node) % alignof(Link) == 0, "forward pointers must be aligned");
+
+    Link m_head[MaxLevels];
+    //levels any node was linked on, only grows, searches start below it
+    std::atomic<size_t> m_levels{1};
+    StripedCounter m_size;
+
+    static Node* _ptr(uintptr_t link) { return reinterpret_cast<Node*>(link & ~uintptr_t(1)); }
+
+    static bool _marked(uintptr_t link) { return link & 1; }
+
+    static uintptr_t _pack(Node* n, bool mark = false) { return reinterpret_cast<uintptr_t>(n) | uintptr_t(mark); }
+
+    static Node* _make_node(const T& val, size_t height) {
+        void* mem = ::operator new(sizeof(Node) + height * sizeof(Link));
+        Node* n = ::new (mem) Node(val, height);
+        for (size_t i = 0; i < height; i++)
+            ::new (&n->_link(i)) Link(0);
+        return n;
+    }
+
+    static void _free_node(void* ptr) {
+        Node* n = static_cast<Node*>(ptr);
+        for (size_t i = 0; i < n->_height; i++)
+            n->_link(i).~Link();
+        n->~Node();
+        ::operator delete(n);
+    }
+
+    static void _release(Node* n) {
+        if (n->_refs.fetch_sub(1) == 1)
+            Epoch::retire(n, &_free_node);
+    }
+
+    //nullptr stands for the head
+    Link& _next(Node* prev, size_t lvl) {
+        return prev ? prev->_link(lvl) : m_head[lvl];
+    }
+
+    //every thread draws levels from its own generator
+    static size_t _random_height() {
+        thread_local std::mt19937_64 rng(std::random_device{}() ^ std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        return std::min<size_t>(std::countr_zero(rng() | (uint64_t(1) << 63)) + 1, MaxLevels);
+    }
+
+    //raises m_levels before node of height is linked
+    void _raise(size_t height) {
+        size_t top = m_levels.load();
+        for (;top < height && !m_levels.compare_exchange_weak(top, height););
+    }
+
+    //fills preds and succs on every level in use, unlinks marked nodes on the way
+    //returns true if succs[0] holds val
+    bool _find(const T& val, Node** preds, Node** succs) {
+    retry:
+        Node* prev = nullptr;
+
+        for (size_t lvl = m_levels.load(); lvl--;){
+            Node* curr = _ptr(_next(prev, lvl).load());
+
+            for (;curr;){
+                uintptr_t succ = curr->_link(lvl).load();
+
+                for (;_marked(succ);){
+                    uintptr_t expected = _pack(curr);
+                    if (!_next(prev, lvl).compare_exchange_strong(expected, _pack(_ptr(succ))))
+                        goto retry;
+
+                    curr = _ptr(succ);
+                    if (!curr)
+                        break;
+                    succ = curr->_link(lvl).load();
+                }
+
+                if (curr && curr->_data < val){
+                    prev = curr;
+                    curr = _ptr(succ);
+                } else break;
+            }
+
+            preds[lvl] = prev;
+            succs[lvl] = curr;
+        }
+
+        return succs[0] && !(val < succs[0]->_data);
+    }
+
+public:
+
+    ConcurrentSkipList() {
+        for (auto& l : m_head)
+            l.store(0);
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    //must not race with other operations
+    ~ConcurrentSkipList() {
+        for (Node* it = _ptr(m_head[0].load()); it;){
+            Node* next = _ptr(it->_link(0).load());
+            _free_node(it);
+            it = next;
+        }
+    }
+
+    bool insert(const T& val) {
+        auto guard = Epoch::pin();
+        Node* preds[MaxLevels];
+        Node* succs[MaxLevels];
+        Node* n = nullptr;
+        size_t height = _random_height();
+        _raise(height);
+
+        for (;;){
+            if (_find(val, preds, succs)){
+                if (n)
+                    _free_node(n);
+                return false;
+            }
+
+            if (!n)
+                n = _make_node(val, height);
+
+            for (size_t lvl = 0; lvl < n->_height; lvl++)
+                n->_link(lvl).store(_pack(succs[lvl]), std::memory_order_relaxed);
+
+            uintptr_t expected = _pack(succs[0]);
+            if (_next(preds[0], 0).compare_exchange_strong(expected, _pack(n)))
+                break;
+        }
+
+        m_size.add(1);
+
+        //node is in the set, upper levels are only shortcuts
+        for (size_t lvl = 1; lvl < n->_height; lvl++){
+            for (;;){
+                uintptr_t own = n->_link(lvl).load();
+
+                if (_marked(own))
+                    goto done;
+
+                if (_ptr(own) != succs[lvl] && !n->_link(lvl).compare_exchange_strong(own, _pack(succs[lvl])))
+                    continue;
+
+                uintptr_t expected = _pack(succs[lvl]);
+                if (_next(preds[lvl], lvl).compare_exchange_strong(expected, _pack(n)))
+                    break;
+
+                _find(val, preds, succs);
+                if (succs[0] != n)
+                    goto done;
+            }
+        }
+
+    done:
+        //erase could have run while upper levels were linked
+        if (_marked(n->_link(0).load()))
+            _find(val, preds, succs);
+
+        _release(n);
+        return true;
+    }
+
+    bool erase(const T& val) {
+        auto guard = Epoch::pin();
+        Node* preds[MaxLevels];
+        Node* succs[MaxLevels];
+
+        if (!_find(val, preds, succs))
+            return false;
+
+        Node* victim = succs[0];
+
+        for (size_t lvl = victim->_height; --lvl > 0;){
+            uintptr_t succ = victim->_link(lvl).load();
+            for (;!_marked(succ) && !victim->_link(lvl).compare_exchange_weak(succ, succ | 1););
+        }
+
+        uintptr_t succ = victim->_link(0).load();
+        for (;;){
+            if (_marked(succ))
+                return false;
+
+            if (victim->_link(0).compare_exchange_weak(succ, succ | 1))
+                break;
+        }
+
+        m_size.add(-1);
+        _find(val, preds, succs);
+        _release(victim);
+        return true;
+    }
+
+    //wait-free: never writes, only steps over marked nodes
+    bool contains(const T& val) {
+        auto guard = Epoch::pin();
+        Node* prev = nullptr;
+        Node* curr = nullptr;
+
+        for (size_t lvl = m_levels.load(); lvl--;){
+            curr = _ptr(_next(prev, lvl).load());
+
+            for (;curr;){
+                uintptr_t succ = curr->_link(lvl).load();
+
+                if (_marked(succ)){
+                    curr = _ptr(succ);
+                } else if (curr->_data < val){
+                    prev = curr;
+                    curr = _ptr(succ);
+                } else break;
+            }
+        }
+
+        return curr && !(val < curr->_data);
+    }
+
+    //weakly consistent walk over level 0
+    template<typename F>
+    void for_each(F&& func) {
+        auto guard = Epoch::pin();
+
+        for (Node* it = _ptr(m_head[0].load()); it;){
+            uintptr_t next = it->_link(0).load();
+            if (!_marked(next))
+                func(it->_data);
+            it = _ptr(next);
+        }
+    }
+
+    size_t size() const { return m_size.value(); }
+
+    bool empty() const { return !size(); }
+
+};
+
+} //DS namespace
+
+#endif //CONCURRENT_SKIP_LIST_HPP
@@ -0,0 +1,308 @@
+#ifndef DETERMINISTIC_SKIP_LIST_HPP
+#define DETERMINISTIC_SKIP_LIST_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace DS {
+
+//1-2-3 skip list (Munro, Papadakis, Sedgewick) with top-down updates
+//every level is a linked list ending with +inf node, node on level above
+//holds the biggest key of its gap below and points to the gap's first node
+//gaps hold 2..4 nodes, i.e. 1..3 elements between neighbour towers,
+//insert splits full gaps and remove borrows or merges minimal ones on
+//the way down, so height is at most log2(n) + 2 and search never does
+//more than 3 comparisons per level, no randomness involved
+//insert and remove move keys between nodes: they invalidate iterators
+template<typename T>
+class DeterministicSkipList {
+
+    //nullopt key is +inf
+    struct Node {
+        std::optional<T> _key;
+        Node* _right;
+        Node* _down;
+    };
+
+    static constexpr size_t MaxHeight = 96;
+
+    //first node of the top level, top level is always a single +inf node
+    Node* m_head;
+    size_t m_size{0};
+    size_t m_height{1};
+
+    static bool _less(const Node* n, const T& key) {
+        return n->_key && *n->_key < key;
+    }
+
+    //first node after gap of n on the level below
+    static Node* _gap_end(const Node* n) {
+        return n->_right ? n->_right->_down : nullptr;
+    }
+
+    static size_t _gap(const Node* n) {
+        size_t res = 0;
+        for (Node* it = n->_down, *end = _gap_end(n); it != end; it = it->_right, res++);
+        return res;
+    }
+
+    //first level 0 node not less than key
+    Node* _lower_bound(const T& key) const {
+        Node* n = m_head;
+
+        for (;;){
+            for (;_less(n, key); n = n->_right);
+
+            if (!n->_down)
+                return n;
+
+            n = n->_down;
+        }
+    }
+
+    //collapses top level once it has nothing to separate
+    void _shrink(Node* parent) {
+        if (parent == m_head && !parent->_down->_right){
+            m_head = parent->_down;
+            delete parent;
+            m_height--;
+        }
+    }
+
+    //grows minimal gap of d (child of parent, prev is left neighbour of d
+    //in the same gap) before descending into it; returns node whose gap
+    //holds what d's gap held
+    Node* _fix(Node* parent, Node* prev, Node* d) {
+        if (d->_right != _gap_end(parent)){
+            Node* next = d->_right;
+
+            if (_gap(next) > 2){
+                //first node of next gap moves to d
+                Node* first = next->_down;
+                d->_key = first->_key;
+                next->_down = first->_right;
+            } else {
+                d->_key = std::move(next->_key);
+                d->_right = next->_right;
+                delete next;
+                _shrink(parent);
+            }
+
+            return d;
+        }
+
+        if (_gap(prev) > 2){
+            //last node of prev gap moves to d
+            Node* q = prev->_down;
+            for (;q->_right->_right != d->_down; q = q->_right);
+            prev->_key = q->_key;
+            d->_down = q->_right;
+            return d;
+        }
+
+        prev->_key = std::move(d->_key);
+        prev->_right = d->_right;
+        delete d;
+        _shrink(parent);
+        return prev;
+    }
+
+public:
+
+    //to support STL, walks level 0
+    struct Iterator {
+
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() = default;
+
+        explicit Iterator(Node* ptr):m_ptr{ptr && ptr->_key ? ptr : nullptr} {}
+
+        reference operator*() const { return *m_ptr->_key; }
+
+        pointer operator->() const { return &*m_ptr->_key; }
+
+        Iterator& operator++() {
+            m_ptr = m_ptr->_right->_key ? m_ptr->_right : nullptr;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return m_ptr == other.m_ptr; }
+
+        bool operator!=(const Iterator& other) const { return m_ptr != other.m_ptr; }
+
+        operator bool() const { return m_ptr; }
+
+    private:
+
+        Node* m_ptr{nullptr};
+    };
+
+    using iterator = Iterator;
+
+    DeterministicSkipList():m_head{new Node{std::nullopt, nullptr, nullptr}} {}
+
+    DeterministicSkipList(const DeterministicSkipList&) = delete;
+
+    DeterministicSkipList& operator=(const DeterministicSkipList&) = delete;
+
+    ~DeterministicSkipList() {
+        clear();
+        delete m_head;
+    }
+
+    void clear() {
+        for (Node* lvl = m_head; lvl;){
+            Node* below = lvl->_down;
+
+            for (Node* it = lvl; it;){
+                Node* next = it->_right;
+                delete it;
+                it = next;
+            }
+
+            lvl = below;
+        }
+
+        m_head = new Node{std::nullopt, nullptr, nullptr};
+        m_size = 0;
+        m_height = 1;
+    }
+
+    bool empty() const { return !m_size; }
+
+    size_t size() const { return m_size; }
+
+    //number of levels including level 0
+    size_t height() const { return m_height; }
+
+    //returns position of key and false if it was already there
+    std::pair<iterator, bool> insert(const T& key) {
+        Node* n = m_head;
+        bool inserted = false;
+
+        for (;;){
+            for (;_less(n, key); n = n->_right);
+
+            if (!n->_down){
+                if (!n->_key || key < *n->_key){
+                    //key takes place of n, n's key moves to new node right after it
+                    //so gap boundaries above stay the same
+                    n->_right = new Node{std::move(n->_key), n->_right, nullptr};
+                    n->_key = key;
+                    m_size++;
+                    inserted = true;
+                }
+
+                break;
+            }
+
+            Node* first = n->_down;
+
+            //full gap: middle element is raised and the gap split in two,
+            //key is searched again on this level
+            if (_gap(n) == 4){
+                Node* mid = first->_right;
+                n->_right = new Node{std::move(n->_key), n->_right, mid->_right};
+                n->_key = mid->_key;
+                continue;
+            }
+
+            n = first;
+        }
+
+        //top gap was split on the way down
+        if (m_head->_right){
+            m_head = new Node{std::nullopt, nullptr, m_head};
+            m_height++;
+        }
+
+        return {iterator(n), inserted};
+    }
+
+    //returns false if key is not present
+    bool remove(const T& key) {
+        if (!m_size)
+            return false;
+
+        //nodes on the way which carry key as gap maximum
+        Node* carriers[MaxHeight];
+        size_t cnt = 0;
+
+        for (Node* parent = m_head;;){
+            Node* prev = nullptr;
+            Node* d = parent->_down;
+            for (;_less(d, key); prev = d, d = d->_right);
+
+            if (!d->_down){
+                if (!d->_key || key < *d->_key)
+                    return false;
+
+                if (d->_right != _gap_end(parent)){
+                    if (prev){
+                        prev->_right = d->_right;
+                        delete d;
+                    } else {
+                        //first node of gap is pointed from above, its
+                        //successor is removed instead
+                        Node* next = d->_right;
+                        d->_key = std::move(next->_key);
+                        d->_right = next->_right;
+                        delete next;
+                    }
+                } else {
+                    //key was maximum of gaps up the way, predecessor takes its role
+                    prev->_right = d->_right;
+                    for (size_t i = 0; i < cnt; i++)
+                        carriers[i]->_key = prev->_key;
+                    delete d;
+                }
+
+                m_size--;
+                return true;
+            }
+
+            if (_gap(d) == 2)
+                d = _fix(parent, prev, d);
+
+            if (d->_key && !(key < *d->_key))
+                carriers[cnt++] = d;
+
+            parent = d;
+        }
+    }
+
+    iterator lower_bound(const T& key) const { return iterator(_lower_bound(key)); }
+
+    iterator find(const T& key) const {
+        Node* n = _lower_bound(key);
+        return n->_key && !(key < *n->_key) ? iterator(n) : end();
+    }
+
+    bool contains(const T& key) const { return find(key) != end(); }
+
+    iterator begin() const {
+        Node* n = m_head;
+        for (;n->_down; n = n->_down);
+        return iterator(n);
+    }
+
+    iterator end() const { return iterator(); }
+
+};
+
+} //DS namespace
+
+#endif //DETERMINISTIC_SKIP_LIST_HPP
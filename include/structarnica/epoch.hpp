@@ -0,0 +1,177 @@
+#ifndef EPOCH_HPP
+#define EPOCH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace DS {
+
+//epoch based memory reclamation for lock-free structures
+//readers pin the current epoch for the time they hold raw pointers,
+//unlinked nodes are passed to retire() and freed two epochs later,
+//when no pinned thread can reach them anymore
+class Epoch {
+
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    //one record per thread, records are reused after thread exit
+    struct Record {
+
+        //epoch << 1 | pinned bit
+        std::atomic<uint64_t> local{0};
+        std::atomic<bool> owned{false};
+        Record* next{nullptr};
+
+        //fields below are touched only by the owning thread
+        unsigned nesting{0};
+        unsigned retired{0};
+        uint64_t stamps[3]{0, 0, 0};
+        std::vector<Retired> bags[3];
+
+        void collect(uint64_t epoch) {
+            for (size_t i = 0; i < 3; i++){
+                if (stamps[i] + 2 > epoch)
+                    continue;
+
+                for (auto& r : bags[i])
+                    r.deleter(r.ptr);
+                bags[i].clear();
+            }
+        }
+
+        void free_all() {
+            for (auto& bag : bags){
+                for (auto& r : bag)
+                    r.deleter(r.ptr);
+                bag.clear();
+            }
+        }
+    };
+
+    struct Registry {
+
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<Record*> head{nullptr};
+
+        ~Registry() {
+            for (Record* r = head.load(); r;){
+                Record* next = r->next;
+                r->free_all();
+                delete r;
+                r = next;
+            }
+        }
+
+        Record* acquire() {
+            for (Record* r = head.load(); r; r = r->next){
+                bool expected = false;
+                if (!r->owned.load() && r->owned.compare_exchange_strong(expected, true))
+                    return r;
+            }
+
+            Record* r = new Record();
+            r->owned.store(true);
+            r->next = head.load();
+            for (;!head.compare_exchange_weak(r->next, r););
+            return r;
+        }
+
+        //epoch moves forward only when every pinned thread has seen the current one
+        void try_advance() {
+            uint64_t e = epoch.load();
+
+            for (Record* r = head.load(); r; r = r->next){
+                uint64_t l = r->local.load();
+                if ((l & 1) && (l >> 1) != e)
+                    return;
+            }
+
+            epoch.compare_exchange_strong(e, e + 1);
+        }
+    };
+
+    struct Holder {
+
+        Record* rec{nullptr};
+
+        ~Holder() {
+            if (rec)
+                rec->owned.store(false);
+        }
+    };
+
+    static Registry& _registry() {
+        static Registry reg;
+        return reg;
+    }
+
+    static Record& _local() {
+        thread_local Holder holder;
+
+        if (!holder.rec)
+            holder.rec = _registry().acquire();
+
+        return *holder.rec;
+    }
+
+public:
+
+    //RAII critical section, guards may nest
+    struct Guard {
+
+        Guard():m_rec{&_local()} {
+            if (m_rec->nesting++)
+                return;
+
+            //read-modify-write acts as a full fence before pointers are loaded
+            m_rec->local.exchange((_registry().epoch.load() << 1) | 1);
+        }
+
+        Guard(const Guard&) = delete;
+
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() {
+            if (!--m_rec->nesting)
+                m_rec->local.store(0, std::memory_order_release);
+        }
+
+    private:
+
+        Record* m_rec;
+    };
+
+    static Guard pin() { return Guard(); }
+
+    //ptr must be already unreachable for threads that pin after this call
+    static void retire(void* ptr, void (*deleter)(void*)) {
+        Registry& reg = _registry();
+        Record& rec = _local();
+
+        uint64_t e = reg.epoch.load();
+        rec.collect(e);
+
+        size_t slot = e % 3;
+        rec.stamps[slot] = e;
+        rec.bags[slot].push_back({ptr, deleter});
+
+        if (++rec.retired % 64 == 0){
+            reg.try_advance();
+            rec.collect(reg.epoch.load());
+        }
+    }
+
+    template<typename T>
+    static void retire(T* ptr) {
+        retire(ptr, [](void* p){ delete static_cast<T*>(p); });
+    }
+
+};
+
+} //DS namespace
+
+#endif //EPOCH_HPP
@@ -0,0 +1,127 @@
+#ifndef EXPIRY_INDEX_HPP
+#define EXPIRY_INDEX_HPP
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <structarnica/skip_list.hpp>
+
+namespace DS {
+
+//deadline ordered index for TTL expiration on top of SkipList
+//entries are ordered by (deadline, insertion sequence), the pair is also
+//a handle used to reschedule or cancel entry
+//pop_until detaches whole expired prefix with SkipList::split_at, only
+//links crossing the cut are rewired: O(log n), the batch is walked by caller
+template<typename Payload, typename Deadline = uint64_t>
+class ExpiryIndex {
+
+public:
+
+    struct Handle {
+        Deadline deadline;
+        uint64_t seq;
+    };
+
+    struct Entry {
+
+        Deadline deadline;
+        uint64_t seq;
+        Payload payload;
+
+        Handle handle() const { return {deadline, seq}; }
+
+        friend bool operator<(const Entry& a, const Entry& b) { return _less(a, b); }
+
+        friend bool operator<(const Entry& a, const Handle& h) { return _less(a, h); }
+
+        friend bool operator<(const Handle& h, const Entry& a) { return _less(h, a); }
+
+    private:
+
+        template<typename A, typename B>
+        static bool _less(const A& a, const B& b) {
+            return a.deadline < b.deadline || (!(b.deadline < a.deadline) && a.seq < b.seq);
+        }
+    };
+
+    //expired entries in deadline order
+    using Batch = SkipList<Entry>;
+
+    ExpiryIndex() = default;
+
+    //payload is moved into the list, pass rvalue to avoid a copy
+    Handle insert(Deadline deadline, Payload payload) {
+        Handle res{deadline, m_seq++};
+        m_list.insert(Entry{deadline, res.seq, std::move(payload)});
+        return res;
+    }
+
+    //removes and returns every entry with deadline not after now
+    Batch pop_until(Deadline now) {
+        Batch rest = m_list.split_at(Cutoff{now});
+        m_list.swap(rest);
+        return rest;
+    }
+
+    //moves entry to new deadline, returns its new handle, payload is
+    //moved, never copied; nullopt if handle is not in the index
+    std::optional<Handle> reschedule(const Handle& handle, Deadline deadline) {
+        auto it = m_list.find(handle);
+
+        if (!it)
+            return std::nullopt;
+
+        Payload payload = std::move(it->payload);
+        m_list.erase(it);
+        return insert(deadline, std::move(payload));
+    }
+
+    //returns false if handle is not in the index
+    bool cancel(const Handle& handle) {
+        auto it = m_list.find(handle);
+
+        if (!it)
+            return false;
+
+        m_list.erase(it);
+        return true;
+    }
+
+    bool contains(const Handle& handle) { return m_list.contains(handle); }
+
+    //earliest deadline, nullopt if index is empty
+    std::optional<Deadline> next_deadline() {
+        auto it = m_list.begin();
+        return it ? std::optional<Deadline>{it->deadline} : std::nullopt;
+    }
+
+    void clear() { m_list.clear(); }
+
+    bool empty() const { return m_list.empty(); }
+
+    size_t size() const { return m_list.size(); }
+
+    typename Batch::iterator begin() { return m_list.begin(); }
+    typename Batch::iterator end() { return m_list.end(); }
+
+private:
+
+    //entries with deadline not after now are less than the cutoff
+    struct Cutoff {
+
+        Deadline now;
+
+        friend bool operator<(const Entry& a, const Cutoff& c) { return !(c.now < a.deadline); }
+
+        friend bool operator<(const Cutoff& c, const Entry& a) { return c.now < a.deadline; }
+    };
+
+    SkipList<Entry> m_list;
+    uint64_t m_seq{0};
+
+};
+
+} //DS namespace
+
+#endif //EXPIRY_INDEX_HPP
@@ -0,0 +1,134 @@
+#ifndef FROZEN_BST_HPP
+#define FROZEN_BST_HPP
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include <structarnica/util.hpp>
+
+namespace DS {
+
+//immutable search tree in one flat array, made by BST::freeze()
+//keys are in Eytzinger (BFS) order: children of slot k are 2k and 2k + 1
+//(counting from 1), so top levels share few cache lines and search is
+//one branchless compare per level; the line with descendants four
+//levels down is prefetched while the current one is compared
+//copies and ranks are kept in separate arrays, search touches keys only
+template<typename T, typename Compare = std::less<T>>
+class FrozenBST {
+
+public:
+
+    FrozenBST() = default;
+
+    //keys are sorted and distinct, counts[i] is number of copies of keys[i]
+    //empty counts means one copy of each key
+    explicit FrozenBST(const std::vector<T>& keys, const std::vector<unsigned>& counts = {}, Compare comp = Compare()):
+        m_comp{std::move(comp)}
+    {
+        if (!counts.empty() && counts.size() != keys.size())
+            throw std::invalid_argument("FrozenBST: counts do not match keys");
+
+        for (size_t i = 1; i < keys.size(); i++){
+            if (!m_comp(keys[i - 1], keys[i]))
+                throw std::invalid_argument("FrozenBST: keys are not sorted and distinct");
+        }
+
+        std::vector<size_t> order(keys.size());
+        _layout(order, 0, 1);
+
+        std::vector<size_t> before(keys.size() + 1, 0);
+        for (size_t i = 0; i < keys.size(); i++)
+            before[i + 1] = before[i] + (counts.empty() ? 1 : counts[i]);
+
+        m_keys.reserve(keys.size());
+        m_before.reserve(keys.size());
+        m_count.reserve(keys.size());
+
+        for (size_t i : order){
+            m_keys.push_back(keys[i]);
+            m_before.push_back(before[i]);
+            m_count.push_back(counts.empty() ? 1 : counts[i]);
+        }
+
+        m_size = before.back();
+    }
+
+    template<typename K = T>
+    bool contains(const K& key) const {
+        size_t k = _lower_bound(key);
+        return k && !m_comp(key, m_keys[k - 1]);
+    }
+
+    //copies of key
+    template<typename K = T>
+    unsigned count(const K& key) const {
+        size_t k = _lower_bound(key);
+        return k && !m_comp(key, m_keys[k - 1]) ? m_count[k - 1] : 0;
+    }
+
+    //first key not less than key, nullptr if there is none
+    template<typename K = T>
+    const T* lower_bound(const K& key) const {
+        size_t k = _lower_bound(key);
+        return k ? &m_keys[k - 1] : nullptr;
+    }
+
+    //number of elements less than key, copies included
+    template<typename K = T>
+    size_t rank(const K& key) const {
+        size_t k = _lower_bound(key);
+        return k ? m_before[k - 1] : m_size;
+    }
+
+    //elements with copies
+    size_t size() const { return m_size; }
+
+    size_t distinct() const { return m_keys.size(); }
+
+    bool empty() const { return !m_size; }
+
+private:
+
+    //order[slot - 1] = position in sorted keys, in order walk of implicit tree
+    size_t _layout(std::vector<size_t>& order, size_t pos, size_t slot) {
+        if (slot > order.size())
+            return pos;
+
+        pos = _layout(order, pos, 2 * slot);
+        order[slot - 1] = pos++;
+        return _layout(order, pos, 2 * slot + 1);
+    }
+
+    //slot of lower bound counting from 1, 0 if every key is less
+    //descent goes right on every "less" and left otherwise, the answer is
+    //the last left turn: trailing ones of k are right turns after it
+    template<typename K>
+    size_t _lower_bound(const K& key) const {
+        const T* keys = m_keys.data();
+        size_t n = m_keys.size();
+        size_t k = 1;
+
+        for (;k <= n;){
+            DS_PREFETCH(keys + std::min(16 * k, n) - 1);
+            k = 2 * k + m_comp(keys[k - 1], key);
+        }
+
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    std::vector<T> m_keys;
+    //elements before the key in sorted order
+    std::vector<size_t> m_before;
+    std::vector<unsigned> m_count;
+    size_t m_size{0};
+    //const lookups call it, comparator of BST may have non-const operator()
+    mutable Compare m_comp;
+
+};
+
+} //DS namespace
+
+#endif //FROZEN_BST_HPP
@@ -0,0 +1,310 @@
+#ifndef MVCC_SKIP_LIST_HPP
+#define MVCC_SKIP_LIST_HPP
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <structarnica/skip_list.hpp>
+
+namespace DS {
+
+//multi version set on top of SkipList
+//every insert and remove gets sequence number and is stored as version
+//of its key, remove leaves a tombstone; snapshot() pins a sequence number
+//and iterates only entries visible at it while writers go on
+//versions no live snapshot can see are dropped, keys whose last visible
+//version is a tombstone are unlinked
+//all operations are synchronized with internal shared mutex, snapshot
+//iterators lock it per step so long reads don't stall writers
+template<typename T>
+class MVCCSkipList {
+
+    struct Version {
+        uint64_t seq;
+        bool tombstone;
+        Version* older;
+    };
+
+    //list copies entries, so entry doesn't own its versions;
+    //chains are freed explicitly before entry leaves the list
+    struct Entry {
+
+        T key;
+        Version* versions;
+
+        friend bool operator<(const Entry& a, const Entry& b) { return a.key < b.key; }
+
+        friend bool operator<(const Entry& a, const T& key) { return a.key < key; }
+
+        friend bool operator<(const T& key, const Entry& a) { return key < a.key; }
+    };
+
+    using list_iterator = typename SkipList<Entry>::iterator;
+
+    static constexpr uint64_t Latest = std::numeric_limits<uint64_t>::max();
+
+    SkipList<Entry> m_list;
+    uint64_t m_seq{0};
+    size_t m_live{0};
+    size_t m_versions{0};
+    //live snapshots: sequence -> number of handles
+    std::map<uint64_t, size_t> m_snapshots;
+    //keys that got a new version, with its sequence, oldest first
+    std::deque<std::pair<uint64_t, T>> m_garbage;
+    mutable std::shared_mutex m_mutex;
+
+    static const Version* _visible(const Entry& e, uint64_t seq) {
+        const Version* v = e.versions;
+        for (;v && v->seq > seq; v = v->older);
+        return v && !v->tombstone ? v : nullptr;
+    }
+
+    static list_iterator _skip(list_iterator it, uint64_t seq) {
+        for (;it && !_visible(*it, seq); ++it);
+        return it;
+    }
+
+    //oldest sequence somebody may still read
+    uint64_t _horizon() const {
+        return m_snapshots.empty() ? m_seq : m_snapshots.begin()->first;
+    }
+
+    void _free_versions(Version* v) {
+        for (;v;){
+            Version* older = v->older;
+            delete v;
+            m_versions--;
+            v = older;
+        }
+    }
+
+    //drops versions hidden from every reader, unlinks dead keys
+    void _prune(list_iterator it, uint64_t horizon) {
+        Version** link = &it->versions;
+        for (;*link && (*link)->seq > horizon; link = &(*link)->older);
+
+        if (!*link)
+            return;
+
+        //newest version every reader sees, older ones are unreachable
+        Version* keep = *link;
+        _free_versions(keep->older);
+        keep->older = nullptr;
+
+        //tombstone everybody sees is the same as no version at all
+        if (keep->tombstone){
+            _free_versions(keep);
+            *link = nullptr;
+        }
+
+        if (!it->versions)
+            m_list.erase(it);
+    }
+
+    void _write(const T& key, bool tombstone) {
+        uint64_t seq = ++m_seq;
+        auto it = m_list.insert_unique(Entry{key, nullptr}).first;
+
+        it->versions = new Version{seq, tombstone, it->versions};
+        m_versions++;
+
+        if (m_snapshots.empty())
+            _prune(it, seq);
+        else m_garbage.emplace_back(seq, key);
+    }
+
+    void _collect() {
+        uint64_t horizon = _horizon();
+
+        for (;!m_garbage.empty() && m_garbage.front().first <= horizon; m_garbage.pop_front()){
+            auto it = m_list.find(m_garbage.front().second);
+            if (it)
+                _prune(it, horizon);
+        }
+    }
+
+    void _release(uint64_t seq) {
+        std::unique_lock lock(m_mutex);
+
+        auto it = m_snapshots.find(seq);
+        if (!--it->second)
+            m_snapshots.erase(it);
+
+        _collect();
+    }
+
+public:
+
+    //forward iterator over keys visible at fixed sequence
+    struct Iterator {
+
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() = default;
+
+        Iterator(const MVCCSkipList* owner, list_iterator it, uint64_t seq):
+            m_owner{owner}, m_it{it}, m_seq{seq} {}
+
+        reference operator*() { return m_it->key; }
+
+        pointer operator->() { return &m_it->key; }
+
+        Iterator& operator++() {
+            std::shared_lock lock(m_owner->m_mutex);
+            m_it = _skip(++m_it, m_seq);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return m_it == other.m_it; }
+
+        bool operator!=(const Iterator& other) const { return m_it != other.m_it; }
+
+    private:
+
+        const MVCCSkipList* m_owner{nullptr};
+        list_iterator m_it;
+        uint64_t m_seq{0};
+    };
+
+    using iterator = Iterator;
+
+    //point in time view, releases its sequence on destruction
+    class Snapshot {
+
+    public:
+
+        Snapshot(Snapshot&& other):m_owner{other.m_owner}, m_seq{other.m_seq} {
+            other.m_owner = nullptr;
+        }
+
+        Snapshot(const Snapshot&) = delete;
+
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        ~Snapshot() {
+            if (m_owner)
+                m_owner->_release(m_seq);
+        }
+
+        uint64_t sequence() const { return m_seq; }
+
+        bool contains(const T& key) const {
+            std::shared_lock lock(m_owner->m_mutex);
+            auto it = m_owner->m_list.find(key);
+            return it && _visible(*it, m_seq);
+        }
+
+        iterator begin() const {
+            std::shared_lock lock(m_owner->m_mutex);
+            return iterator(m_owner, _skip(m_owner->m_list.begin(), m_seq), m_seq);
+        }
+
+        iterator end() const { return iterator(m_owner, list_iterator(), m_seq); }
+
+        friend MVCCSkipList;
+
+    private:
+
+        Snapshot(MVCCSkipList* owner, uint64_t seq):m_owner{owner}, m_seq{seq} {}
+
+        MVCCSkipList* m_owner;
+        uint64_t m_seq;
+    };
+
+    MVCCSkipList() = default;
+
+    MVCCSkipList(const MVCCSkipList&) = delete;
+
+    MVCCSkipList& operator=(const MVCCSkipList&) = delete;
+
+    //snapshots must not outlive the list
+    ~MVCCSkipList() {
+        for (auto& e : m_list)
+            _free_versions(e.versions);
+    }
+
+    //returns false if key is already present
+    bool insert(const T& key) {
+        std::unique_lock lock(m_mutex);
+
+        auto it = m_list.find(key);
+        if (it && _visible(*it, Latest))
+            return false;
+
+        _write(key, false);
+        m_live++;
+        return true;
+    }
+
+    //returns false if key is not present
+    bool remove(const T& key) {
+        std::unique_lock lock(m_mutex);
+
+        auto it = m_list.find(key);
+        if (!it || !_visible(*it, Latest))
+            return false;
+
+        _write(key, true);
+        m_live--;
+        return true;
+    }
+
+    bool contains(const T& key) {
+        std::shared_lock lock(m_mutex);
+        auto it = m_list.find(key);
+        return it && _visible(*it, Latest);
+    }
+
+    Snapshot snapshot() {
+        std::unique_lock lock(m_mutex);
+        m_snapshots[m_seq]++;
+        return Snapshot(this, m_seq);
+    }
+
+    //number of keys in the latest version
+    size_t size() const {
+        std::shared_lock lock(m_mutex);
+        return m_live;
+    }
+
+    bool empty() const { return !size(); }
+
+    //sequence number of the last write
+    uint64_t sequence() const {
+        std::shared_lock lock(m_mutex);
+        return m_seq;
+    }
+
+    //versions kept for all keys, tombstones included
+    size_t versions() const {
+        std::shared_lock lock(m_mutex);
+        return m_versions;
+    }
+
+    //latest view, follows SkipList iterator invalidation rules
+    iterator begin() {
+        std::shared_lock lock(m_mutex);
+        return iterator(this, _skip(m_list.begin(), Latest), Latest);
+    }
+
+    iterator end() { return iterator(this, list_iterator(), Latest); }
+
+};
+
+} //DS namespace
+
+#endif //MVCC_SKIP_LIST_HPP
@@ -0,0 +1,68 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace DS {
+
+//range partitioned scans over ordered containers with partition(parts),
+//e.g. SkipList: container is cut into balanced ranges through its upper
+//levels, every range is walked by its own thread, the calling thread
+//takes the first one; container must not be modified meanwhile
+//exceptions thrown by func are rethrown in the calling thread
+
+inline size_t _default_threads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+//calls func for every element
+template<typename List, typename Func>
+void parallel_for_each(List& list, Func func, size_t threads = _default_threads()) {
+    auto cuts = list.partition(threads);
+    std::vector<std::future<void>> workers;
+
+    for (size_t i = 1; i + 1 < cuts.size(); i++){
+        workers.push_back(std::async(std::launch::async, [&func, first = cuts[i], last = cuts[i + 1]]() mutable {
+            for (;first != last; ++first)
+                func(*first);
+        }));
+    }
+
+    for (auto it = cuts[0]; it != cuts[1]; ++it)
+        func(*it);
+
+    for (auto& w : workers)
+        w.get();
+}
+
+//folds every range from identity with fold(acc, element),
+//then joins partial results in list order with combine(acc, part)
+template<typename List, typename R, typename Fold, typename Combine>
+R parallel_reduce(List& list, R identity, Fold fold, Combine combine, size_t threads = _default_threads()) {
+    auto cuts = list.partition(threads);
+    std::vector<std::future<R>> workers;
+
+    auto walk = [&fold, &identity](auto first, auto last){
+        R acc = identity;
+        for (;first != last; ++first)
+            acc = fold(std::move(acc), *first);
+        return acc;
+    };
+
+    for (size_t i = 1; i + 1 < cuts.size(); i++)
+        workers.push_back(std::async(std::launch::async, walk, cuts[i], cuts[i + 1]));
+
+    R res = walk(cuts[0], cuts[1]);
+
+    for (auto& w : workers)
+        res = combine(std::move(res), w.get());
+
+    return res;
+}
+
+} //DS namespace
+
+#endif //PARALLEL_HPP
@@ -0,0 +1,214 @@
+#ifndef POOL_BST_HPP
+#define POOL_BST_HPP
+
+#include <cstdint>
+#include <functional>
+#include <stack>
+#include <stdexcept>
+#include <vector>
+
+namespace DS {
+
+//BST with nodes in one contiguous slab, children are 32 bit slot indices
+//instead of pointers, so node of BST<uint32_t> is 16 bytes, not 32
+//new node is appended to the slab or takes slot from free list of erased
+//nodes; clear() drops the slab at once, it is O(1) for trivially
+//destructible T and no chunk is returned to the system
+//behaves like plain BST: equal values are counted in one node
+template<typename T, typename Compare = std::less<T>>
+class PoolBST {
+
+    //no node, end of child link and free list
+    static constexpr uint32_t Nil = UINT32_MAX;
+
+    struct Node {
+
+        Node(const T& val):_data{val} {}
+
+        T _data;
+        uint32_t _count{1};
+        uint32_t _left{Nil};
+        //next free slot while node is on free list
+        uint32_t _right{Nil};
+    };
+
+public:
+
+    static constexpr size_t NodeSize = sizeof(Node);
+
+    PoolBST() = default;
+
+    //reserves slots for cnt nodes, they are then taken without reallocation
+    void reserve(size_t cnt) { m_nodes.reserve(cnt); }
+
+    void insert(const T& val) {
+        uint32_t it = m_root;
+        uint32_t prev = Nil;
+
+        for (;it != Nil;){
+            Node& n = m_nodes[it];
+
+            if (n._data == val){
+                n._count++;
+                m_size++;
+                return;
+            }
+
+            prev = it;
+            it = comp(val, n._data) ? n._left : n._right;
+        }
+
+        //slab may move, parent is found again by index
+        uint32_t idx = _make_node(val);
+
+        if (prev == Nil)
+            m_root = idx;
+        else if (comp(val, m_nodes[prev]._data))
+            m_nodes[prev]._left = idx;
+        else m_nodes[prev]._right = idx;
+
+        m_size++;
+    }
+
+    //removes one copy of val, node goes to free list with the last copy
+    void erase(const T& val) {
+        uint32_t* link = &m_root;
+
+        for (;*link != Nil && !(m_nodes[*link]._data == val);)
+            link = comp(val, m_nodes[*link]._data) ? &m_nodes[*link]._left : &m_nodes[*link]._right;
+
+        if (*link == Nil)
+            return;
+
+        m_size--;
+        uint32_t idx = *link;
+        Node& n = m_nodes[idx];
+
+        if (n._count > 1){
+            n._count--;
+            return;
+        }
+
+        //merging: right subtree hangs on the largest node of the left one
+        if (n._right == Nil){
+            *link = n._left;
+        } else if (n._left == Nil){
+            *link = n._right;
+        } else {
+            uint32_t it = n._left;
+            for (;m_nodes[it]._right != Nil; it = m_nodes[it]._right);
+
+            m_nodes[it]._right = n._right;
+            *link = n._left;
+        }
+
+        n._right = m_free;
+        m_free = idx;
+    }
+
+    bool contains(const T& val) {
+        for (uint32_t it = m_root; it != Nil;){
+            const Node& n = m_nodes[it];
+
+            if (n._data == val)
+                return true;
+
+            it = comp(val, n._data) ? n._left : n._right;
+        }
+
+        return false;
+    }
+
+    //copies of val
+    unsigned count(const T& val) {
+        for (uint32_t it = m_root; it != Nil;){
+            const Node& n = m_nodes[it];
+
+            if (n._data == val)
+                return n._count;
+
+            it = comp(val, n._data) ? n._left : n._right;
+        }
+
+        return 0;
+    }
+
+    const T& min() {
+        if (m_root == Nil)
+            throw std::out_of_range("min: tree is empty");
+
+        uint32_t it = m_root;
+        for (;m_nodes[it]._left != Nil; it = m_nodes[it]._left);
+        return m_nodes[it]._data;
+    }
+
+    const T& max() {
+        if (m_root == Nil)
+            throw std::out_of_range("max: tree is empty");
+
+        uint32_t it = m_root;
+        for (;m_nodes[it]._right != Nil; it = m_nodes[it]._right);
+        return m_nodes[it]._data;
+    }
+
+    //calls func once per node, copies are not repeated
+    template<typename F>
+    void inorder(F&& func) {
+        std::stack<uint32_t> st;
+
+        for (uint32_t it = m_root; it != Nil || !st.empty();){
+            for (;it != Nil; it = m_nodes[it]._left)
+                st.push(it);
+
+            it = st.top();
+            st.pop();
+
+            func(m_nodes[it]._data);
+            it = m_nodes[it]._right;
+        }
+    }
+
+    //slab keeps its capacity for next round
+    void clear() {
+        m_nodes.clear();
+        m_root = m_free = Nil;
+        m_size = 0;
+    }
+
+    //elements with copies
+    size_t size() const { return m_size; }
+
+    bool empty() const { return !m_size; }
+
+    //slots in use and on free list
+    size_t slots() const { return m_nodes.size(); }
+
+private:
+
+    uint32_t _make_node(const T& val) {
+        if (m_free != Nil){
+            uint32_t idx = m_free;
+            m_free = m_nodes[idx]._right;
+            m_nodes[idx] = Node(val);
+            return idx;
+        }
+
+        if (m_nodes.size() == Nil)
+            throw std::length_error("PoolBST: too many nodes");
+
+        m_nodes.emplace_back(val);
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    Compare comp;
+
+    std::vector<Node> m_nodes;
+    uint32_t m_root{Nil};
+    uint32_t m_free{Nil};
+    size_t m_size{0};
+
+};
+
+} //DS namespace
+
+#endif //POOL_BST_HPP
@@ -1,7 +1,11 @@
 #ifndef SKIP_LIST_HPP
 #define SKIP_LIST_HPP
 
+#include <algorithm>
+#include <bit>
 #include <iterator>
+#include <ranges>
+#include <stdexcept>
 #include <random>
 #include <vector>
 #include <optional>
@@ -9,126 +13,418 @@
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <structarnica/arena.hpp>
+#include <structarnica/util.hpp>
 
 namespace DS {
 
-//coin flip must be anything with operator() that returns 0 or 1 // true or false
-static auto coin_flip = std::bind(std::uniform_int_distribution<int>(0, 1), std::mt19937());
-
-template<typename T>
+//Compare orders elements, default std::less<> is transparent, so lookups
+//take any key type comparable with T
+//Alloc is node allocation policy from arena.hpp
+//ArenaNodes turns list into memtable-like buffer: nodes come from big
+//chunks and clear() drops them all at once
+template<typename T, typename Compare = std::less<>, typename Alloc = HeapNodes>
 class SkipList {
 
+public:
+
+    //hard limit of tower height
+    static constexpr size_t MaxLevels = 32;
+
+    //searches advanced together by find_many
+    static constexpr size_t BatchGroup = 16;
+
 private:
 
+    struct Node;
+
+    //forward pointer with its width: number of level 0 steps it skips
+    //width of the last link on a level is distance to the last element
+    struct Link {
+        Node* next{nullptr};
+        size_t span{0};
+    };
+
+    //tower node: value is stored once, followed in the same allocation
+    //by an array of forward links, one per level the node is part of
     struct Node {
 
-        explicit Node(T val):_data{val} {}
+        template<typename V>
+        Node(V&& val, size_t height):_data(std::forward<V>(val)), _height{height} {}
 
         const T& data() const { return _data; }
 
-        Node const* next() const { return _next; }
+        Node const* next() const { return _link(0); }
 
         Node const* prev() const { return _prev; }
 
-        friend SkipList;
+        size_t height() const { return _height; }
 
-    private:
+        Link* _links() { return reinterpret_cast<Link*>(this + 1); }
+
+        const Link* _links() const { return reinterpret_cast<const Link*>(this + 1); }
+
+        Node*& _link(size_t lvl) { return _links()[lvl].next; }
+
+        Node* _link(size_t lvl) const { return _links()[lvl].next; }
+
+        size_t& _span(size_t lvl) { return _links()[lvl].span; }
 
         T _data;
-        Node* _next{nullptr};
+        //back link exists only on level 0, it is used by iterators
         Node* _prev{nullptr};
-        Node* _bottom{nullptr};
+        size_t _height;
+        //tombstone of lazy remove, node stays linked until compact()
+        bool _dead{false};
     };
 
-    //0 level contains all values
-    std::vector<Node*> m_levels;
-
-    Node* _insert_at(size_t lvl, T val, Node* attach_to = nullptr) {
-        Node* head = m_levels[lvl];
-        Node* n = new Node(val);
-        n->_bottom = attach_to;
-
-        if (!head)
-            return m_levels[lvl] = n;
-
-        if (val < head->_data){
-            n->_next = head;
-            n->_prev = head->_prev;
-            head->_prev = n;
-            if (head->_next)
-                head->_next->_prev = n;
-            m_levels[lvl] = n;
-        } else {
-            Node* prev;
-            for (;head && (val > head->_data);){
-                prev = head;
-                head = head->_next;
-            }
-            if (prev->_next)
-                prev->_next->_prev = n;
-            n->_next = prev->_next;
-            prev->_next = n;
-            n->_prev = prev;
-        }
+    static_assert(sizeof(Node) % alignof(Link) == 0, "forward links must be aligned");
+
+    //m_levels[lvl] links head to the first node of level lvl
+    //0 level contains all values, upper levels are added as list grows
+    std::vector<Link> m_levels;
+    size_t m_size{0};
+
+    size_t m_max_levels;
+    //p = 2^-m_shift lets level be taken from trailing zeros of one random word
+    //m_shift = 0 means any other p, level is then drawn from geometric distribution
+    unsigned m_shift{0};
+    double m_log_p;
+    //how many levels are allowed per bit of size, log_{1/p}(2)
+    double m_levels_per_bit;
+    std::mt19937_64 m_rng;
+    Alloc m_alloc;
+    Compare m_comp;
+
+    //update path of last inserted node with positions, it is the finger
+    //next insert starts from; m_finger_levels = 0 means no finger
+    Node* m_finger[MaxLevels]{};
+    size_t m_finger_rank[MaxLevels]{};
+    size_t m_finger_levels{0};
+
+    //lazy delete mode: remove only marks nodes, m_size counts them too
+    bool m_lazy{false};
+    double m_compact_ratio{0.5};
+    size_t m_dead{0};
+
+    //val is moved into node when passed as rvalue
+    template<typename V>
+    Node* _make_node(V&& val, size_t height) {
+        void* mem = m_alloc.allocate(sizeof(Node) + height * sizeof(Link), alignof(Node));
+        Node* n = ::new (mem) Node(std::forward<V>(val), height);
+        std::uninitialized_value_construct_n(n->_links(), height);
+        return n;
+    }
 
+    void _free_node(Node* n) {
+        size_t bytes = sizeof(Node) + n->_height * sizeof(Link);
+        n->~Node();
+        m_alloc.deallocate(n, bytes, alignof(Node));
+    }
+
+    //link of lvl that follows prev, nullptr stands for the head
+    Link& _at(Node* prev, size_t lvl) {
+        return prev ? prev->_links()[lvl] : m_levels[lvl];
+    }
+
+    Node*& _next(Node* prev, size_t lvl) {
+        return _at(prev, lvl).next;
+    }
+
+    //first node from n on level 0 which is not a tombstone
+    static Node* _live(Node* n) {
+        for (;n && n->_dead; n = n->_link(0));
         return n;
     }
 
-    void _clear_lvl(size_t lvl) {
-        Node* head = m_levels[lvl];
+    //level with probability p^(h-1), taken from single 64 bit random word
+    //capped with log_{1/p}(n) + 1 so height grows together with size
+    size_t _random_height() {
+        uint64_t word = m_rng();
+        size_t height = m_shift ?
+            std::countr_zero(word | (uint64_t(1) << 63)) / m_shift + 1 :
+            static_cast<size_t>(std::log1p(-static_cast<double>(word >> 11) * 0x1p-53) / m_log_p) + 1;
 
-        if (!head)
-            return;
+        size_t cap = 1 + static_cast<size_t>(std::bit_width(m_size + 1) * m_levels_per_bit);
+
+        return std::min({height, cap, m_max_levels});
+    }
 
-        Node* prev;
-        for (;head;){
-            prev = head;
-            head = head->_next;
-            delete prev;
+    //adds empty head levels for a node taller than the list
+    void _grow(size_t height, Node** update = nullptr, size_t* rank = nullptr) {
+        for (size_t lvl = m_levels.size(); lvl < height; lvl++){
+            m_levels.push_back({nullptr, m_size});
+            if (update)
+                update[lvl] = nullptr;
+            if (rank)
+                rank[lvl] = 0;
         }
     }
 
     //search from left to right
     //top to bottom
-    Node* _search(T val) {
-        size_t lvl = m_levels.size() - 1;
-        Node* res = m_levels[lvl];
+    //walks every level while before(node data) holds, fills update with
+    //last node visited on every level (nullptr is the head)
+    //and rank with its position (head is 0, first element is 1)
+    //returns first node on level 0 for which before does not hold
+    template<typename Before>
+    Node* _descend(Before&& before, Node** update = nullptr, size_t* rank = nullptr) {
+        return _descend_from(nullptr, 0, m_levels.size(), before, update, rank);
+    }
+
+    //_descend that starts at node prev with position pos, below level top
+    template<typename Before>
+    Node* _descend_from(Node* prev, size_t pos, size_t top, Before&& before, Node** update, size_t* rank) {
+        for (size_t lvl = top; lvl--;){
+            for (;;){
+                Link& link = _at(prev, lvl);
+                if (!link.next || !before(link.next->_data))
+                    break;
+                pos += link.span;
+                prev = link.next;
+            }
+
+            if (update)
+                update[lvl] = prev;
+            if (rank)
+                rank[lvl] = pos;
+        }
+
+        return _next(prev, 0);
+    }
+
+    //same walk as _descend but steered by position, stops before element k
+    Node* _select(size_t k, Node** update = nullptr) {
+        Node* prev = nullptr;
+        size_t pos = 0;
+
+        for (size_t lvl = m_levels.size(); lvl--;){
+            for (;;){
+                Link& link = _at(prev, lvl);
+                if (!link.next || pos + link.span > k)
+                    break;
+                pos += link.span;
+                prev = link.next;
+            }
 
-        for (;!res && lvl; res = m_levels[--lvl]);
+            if (update)
+                update[lvl] = prev;
+        }
 
-        for (;res;){
+        return _next(prev, 0);
+    }
 
-            if (val > res->_data){
+    template<typename K>
+    Node* _lower_bound(const K& key, Node** update = nullptr, size_t* rank = nullptr) {
+        return _descend([this, &key](const T& data){ return m_comp(data, key); }, update, rank);
+    }
 
-                res = res->_next ? res->_next : res->_bottom;
+    //finger search: climbs from the finger, then descends, O(log d) for key
+    //d positions away from finger on either side
+    //key after finger: climbs while successors on next level are less than key
+    //key not after finger: climbs while nodes of the finger path are not
+    //less than key, path below the first node less than key is left behind
+    //any = true: any place among equal keys will do, key equal to finger
+    //goes right after it like a key after finger, so runs of equal keys
+    //are appended in O(1)
+    template<typename K>
+    Node* _finger_bound(const K& key, Node** update, size_t* rank, bool any = false) {
+        if (!m_finger_levels)
+            return _lower_bound(key, update, rank);
+
+        size_t top = m_levels.size();
+        size_t lvl = 0;
+        bool before = any ? m_comp(key, m_finger[0]->_data) : !m_comp(m_finger[0]->_data, key);
+
+        for (;lvl + 1 < top; lvl++){
+            if (before){
+                Node* at = lvl < m_finger_levels ? m_finger[lvl] : nullptr;
+                //tower seen on level below is known not to be less
+                bool seen = lvl && at == m_finger[lvl - 1];
+                if (!at || (!seen && m_comp(at->_data, key)))
+                    break;
+            } else {
+                Node* up = lvl + 1 < m_finger_levels ? m_finger[lvl + 1] : nullptr;
+                Node* next = _next(up, lvl + 1);
+                if (!next || !m_comp(next->_data, key))
+                    break;
+            }
+        }
+
+        //finger is still valid path above lvl
+        for (size_t l = lvl + 1; l < top; l++){
+            update[l] = l < m_finger_levels ? m_finger[l] : nullptr;
+            rank[l] = l < m_finger_levels ? m_finger_rank[l] : 0;
+        }
 
-            } else if (val < res->_data){
+        Node* start = lvl < m_finger_levels ? m_finger[lvl] : nullptr;
+        size_t pos = lvl < m_finger_levels ? m_finger_rank[lvl] : 0;
 
-                if (!lvl) return nullptr;
+        //whole finger path is not less than key, search goes from the head
+        if (before && start && !m_comp(start->_data, key)){
+            start = nullptr;
+            pos = 0;
+        }
 
-                res = res->_prev ? res->_prev->_bottom : m_levels[--lvl];
+        return _descend_from(start, pos, lvl + 1, [this, &key](const T& data){ return m_comp(data, key); }, update, rank);
+    }
 
-            } else break;
+    //lower bound of every key in [first, first + cnt), searches are interleaved:
+    //each round makes one step of every unfinished search and prefetches
+    //the node that search will read next, so misses overlap
+    template<typename It>
+    void _lower_bound_group(It first, size_t cnt, Node** res) {
+        Node* prev[BatchGroup];
+        size_t lvl[BatchGroup];
+        size_t active = cnt;
+
+        for (size_t i = 0; i < cnt; i++){
+            prev[i] = nullptr;
+            lvl[i] = m_levels.size() - 1;
+            DS_PREFETCH(m_levels[lvl[i]].next);
         }
 
-        return res;
+        for (;active;){
+            It key = first;
+
+            for (size_t i = 0; i < cnt; i++, ++key){
+                if (lvl[i] == MaxLevels)
+                    continue;
+
+                Node* n = _next(prev[i], lvl[i]);
+
+                if (n && m_comp(n->_data, *key)){
+                    prev[i] = n;
+                } else if (lvl[i]){
+                    lvl[i]--;
+                } else {
+                    res[i] = n;
+                    lvl[i] = MaxLevels;
+                    active--;
+                    continue;
+                }
+
+                DS_PREFETCH(_next(prev[i], lvl[i]));
+            }
+        }
     }
 
-    void _remove(Node* ptr) {
-        if (!ptr)
-            return;
+    template<typename K>
+    Node* _upper_bound(const K& key, Node** update = nullptr) {
+        return _descend([this, &key](const T& data){ return !m_comp(key, data); }, update);
+    }
+
+    //returns first live node on level 0 equal to val
+    //update is exact path of the result only when there are no tombstones
+    template<typename K>
+    Node* _search(const K& val, Node** update = nullptr) {
+        Node* res = _live(_lower_bound(val, update));
+
+        return res && !m_comp(val, res->_data) ? res : nullptr;
+    }
+
+    //first live node equal to val from lower bound n
+    template<typename K>
+    Node* _live_equal(Node* n, const K& val) {
+        n = _live(n);
+        return n && !m_comp(val, n->_data) ? n : nullptr;
+    }
+
+    //exact update path of node x, equal keys before x are walked on level 0
+    void _path_to(Node* x, Node** update) {
+        _lower_bound(x->_data, update);
+
+        for (Node* it = _next(update[0], 0); it != x; it = it->_link(0)){
+            for (size_t lvl = 0; lvl < it->_height; lvl++)
+                update[lvl] = it;
+        }
+    }
+
+    //links n after update path, rank holds positions of update nodes
+    Node* _link_node(Node* n, Node** update, size_t* rank) {
+        for (size_t lvl = 0; lvl < n->_height; lvl++){
+            Link& link = _at(update[lvl], lvl);
+            size_t before = rank[0] - rank[lvl];
+            n->_links()[lvl] = {link.next, link.span - before};
+            link = {n, before + 1};
+        }
+
+        for (size_t lvl = n->_height; lvl < m_levels.size(); lvl++)
+            _at(update[lvl], lvl).span++;
+
+        n->_prev = update[0];
+        if (n->_link(0))
+            n->_link(0)->_prev = n;
+
+        m_size++;
+
+        for (size_t lvl = 0; lvl < m_levels.size(); lvl++){
+            bool own = lvl < n->_height;
+            m_finger[lvl] = own ? n : update[lvl];
+            m_finger_rank[lvl] = own ? rank[0] + 1 : rank[lvl];
+        }
+        m_finger_levels = m_levels.size();
 
-        Node* next_bot = ptr->_bottom;
-        Node* prev = ptr->_prev;
-        Node* next = ptr->_next;
+        return n;
+    }
+
+    //unlinks and frees [first, last), update is path of first
+    //release = false leaves nodes allocated, caller takes them over
+    void _unlink(Node* first, Node* last, Node** update, bool release = true) {
+        size_t cnt = 0;
+        m_finger_levels = 0;
+
+        for (Node* it = first; it != last; cnt++){
+            Node* next = it->_link(0);
+
+            for (size_t lvl = 0; lvl < it->_height; lvl++){
+                Link& link = _at(update[lvl], lvl);
+                link.next = it->_link(lvl);
+                link.span += it->_span(lvl);
+            }
+
+            if (it->_dead)
+                m_dead--;
+
+            if (release)
+                _free_node(it);
+            it = next;
+        }
 
-        delete ptr;
-        if (prev)
-            prev->_next = next;
-        if (next)
-            next->_prev = prev;
-        if (next_bot)
-            _remove(next_bot);
+        for (size_t lvl = 0; lvl < m_levels.size(); lvl++)
+            _at(update[lvl], lvl).span -= cnt;
+
+        if (last)
+            last->_prev = update[0];
+
+        m_size -= cnt;
+    }
+
+    void _remove(Node* ptr, Node** update) {
+        if (ptr)
+            _unlink(ptr, ptr->_link(0), update);
+    }
+
+    //drops empty levels from the top
+    void _shrink() {
+        for (;m_levels.size() > 1 && !m_levels.back().next; m_levels.pop_back());
+    }
+
+    //empty list with same level parameters
+    SkipList _empty_like() {
+        SkipList res(m_max_levels, 0.5, Alloc(), m_comp);
+        res.m_shift = m_shift;
+        res.m_log_p = m_log_p;
+        res.m_levels_per_bit = m_levels_per_bit;
+        res.m_lazy = m_lazy;
+        res.m_compact_ratio = m_compact_ratio;
+        return res;
     }
 
 public:
@@ -157,8 +453,11 @@ public:
 
         reference operator*() { return m_ptr->_data; }
 
+        pointer operator->() { return &m_ptr->_data; }
+
+        //tombstones of lazy remove are stepped over
         Iterator operator++() {
-            m_ptr = m_ptr->_next;
+            m_ptr = _live(m_ptr->_link(0));
             return *this;
         }
 
@@ -169,14 +468,14 @@ public:
         }
 
         Iterator operator--() {
-            m_ptr = m_ptr->_prev;
+            for (m_ptr = m_ptr->_prev; m_ptr && m_ptr->_dead; m_ptr = m_ptr->_prev);
             return *this;
         }
 
         Iterator operator--(int) {
             Iterator tmp(*this);
-            m_ptr = m_ptr->_prev;
-            return *this;
+            --(*this);
+            return tmp;
         }
 
         bool operator==(const Iterator& other) const { return m_ptr == other.m_ptr; }
@@ -185,7 +484,7 @@ public:
 
         operator bool() const { return m_ptr; }
 
-        friend SkipList<T>;
+        friend SkipList;
 
     private:
 
@@ -193,52 +492,646 @@ public:
 
     };
 
-    using iterator = SkipList<T>::Iterator;
-    using const_iterator = typename SkipList<const T>::Iterator;
+    //read only Iterator, steps over tombstones the same way
+    struct ConstIterator : Iterator {
+
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() = default;
+
+        ConstIterator(const Iterator& it):Iterator(it) {}
+
+        reference operator*() { return Iterator::operator*(); }
+
+        pointer operator->() { return Iterator::operator->(); }
+
+        ConstIterator operator++() { return Iterator::operator++(); }
+
+        ConstIterator operator++(int) { return Iterator::operator++(0); }
+
+        ConstIterator operator--() { return Iterator::operator--(); }
+
+        ConstIterator operator--(int) { return Iterator::operator--(0); }
+    };
+
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    //owning handle of a node taken out by extract(), insert() links the
+    //same allocation into any list of this type, nothing is copied
+    //handle that was not inserted frees its node
+    struct NodeHandle {
+
+        NodeHandle() = default;
+
+        NodeHandle(const NodeHandle&) = delete;
+
+        NodeHandle(NodeHandle&& other):m_node{std::exchange(other.m_node, nullptr)} {}
+
+        NodeHandle& operator=(const NodeHandle&) = delete;
+
+        NodeHandle& operator=(NodeHandle&& other) {
+            std::swap(m_node, other.m_node);
+            return *this;
+        }
+
+        ~NodeHandle() {
+            if (!m_node)
+                return;
+
+            size_t bytes = sizeof(Node) + m_node->_height * sizeof(Link);
+            m_node->~Node();
+            Alloc().deallocate(m_node, bytes, alignof(Node));
+        }
+
+        bool empty() const { return !m_node; }
+
+        operator bool() const { return m_node; }
+
+        //value may be changed while node is out of a list
+        T& value() { return m_node->_data; }
+
+        friend SkipList;
+
+    private:
+
+        explicit NodeHandle(Node* ptr):m_node{ptr} {}
+
+        Node* m_node{nullptr};
+
+    };
+
+    using node_type = NodeHandle;
+
+    //p is probability of promoting node one level up
+    SkipList(size_t max_levels = MaxLevels, double p = 0.5, Alloc alloc = Alloc(), Compare comp = Compare()):
+        m_levels(1),
+        m_max_levels{std::clamp<size_t>(max_levels, 1, MaxLevels)},
+        m_rng{std::random_device{}()},
+        m_alloc{std::move(alloc)},
+        m_comp{std::move(comp)}
+    {
+        if (!(p > 0 && p < 1))
+            throw std::invalid_argument("SkipList: promotion probability must be in (0, 1)");
+
+        for (unsigned k = 1; k < 64; k++){
+            if (p == std::ldexp(1.0, -static_cast<int>(k))){
+                m_shift = k;
+                break;
+            }
+        }
 
-    SkipList(size_t max_levels = 4):m_levels(max_levels, nullptr) {}
+        m_log_p = std::log(p);
+        m_levels_per_bit = std::log(2.0) / -m_log_p;
+    }
+
+    SkipList(const SkipList&) = delete;
+
+    SkipList(SkipList&& other):SkipList(other.m_max_levels) {
+        swap(other);
+    }
+
+    SkipList& operator=(const SkipList&) = delete;
+
+    SkipList& operator=(SkipList&& other) {
+        clear();
+        swap(other);
+        return *this;
+    }
 
     ~SkipList() { clear(); }
 
+    void swap(SkipList& other) {
+        std::swap(m_levels, other.m_levels);
+        std::swap(m_size, other.m_size);
+        std::swap(m_max_levels, other.m_max_levels);
+        std::swap(m_shift, other.m_shift);
+        std::swap(m_log_p, other.m_log_p);
+        std::swap(m_levels_per_bit, other.m_levels_per_bit);
+        std::swap(m_rng, other.m_rng);
+        m_alloc.swap(other.m_alloc);
+        std::swap(m_comp, other.m_comp);
+        std::swap(m_finger, other.m_finger);
+        std::swap(m_finger_rank, other.m_finger_rank);
+        std::swap(m_finger_levels, other.m_finger_levels);
+        std::swap(m_lazy, other.m_lazy);
+        std::swap(m_compact_ratio, other.m_compact_ratio);
+        std::swap(m_dead, other.m_dead);
+    }
+
+    //levels are random unless seeded, reseed to get reproducible shape
+    void seed(uint64_t value) { m_rng.seed(value); }
+
+    size_t levels() const { return m_levels.size(); }
+
+    const Alloc& allocator() const { return m_alloc; }
+
+    //build list from already sorted range in one pass, no searching is done
+    //perfect = true gives every 2^k-th element height k + 1 instead of random one
+    template<std::ranges::input_range R>
+    static SkipList from_sorted(R&& range, size_t max_levels = MaxLevels, bool perfect = false) {
+        SkipList res(max_levels);
+        res.assign_sorted(std::forward<R>(range), perfect);
+        return res;
+    }
+
+    template<std::ranges::input_range R>
+    void assign_sorted(R&& range, bool perfect = false) {
+        clear();
+
+        //last node linked on every level and its position
+        Node* tails[MaxLevels]{};
+        size_t tail_rank[MaxLevels]{};
+
+        for (auto&& val : range){
+            if (tails[0] && m_comp(val, tails[0]->_data)){
+                clear();
+                throw std::logic_error("assign_sorted: range is not sorted");
+            }
+
+            size_t height = perfect ?
+                std::min<size_t>(std::countr_zero(m_size + 1) + 1, m_max_levels) :
+                _random_height();
+
+            _grow(height);
+
+            Node* n = _make_node(val, height);
+            n->_prev = tails[0];
+            m_size++;
+
+            for (size_t lvl = 0; lvl < height; lvl++){
+                _at(tails[lvl], lvl) = {n, m_size - tail_rank[lvl]};
+                tails[lvl] = n;
+                tail_rank[lvl] = m_size;
+            }
+        }
+
+        for (size_t lvl = 0; lvl < m_levels.size(); lvl++){
+            _at(tails[lvl], lvl).span = m_size - tail_rank[lvl];
+            m_finger[lvl] = tails[lvl];
+            m_finger_rank[lvl] = tail_rank[lvl];
+        }
+
+        //appends after bulk load continue from the tail
+        m_finger_levels = m_size ? m_levels.size() : 0;
+    }
+
+    //with bulk releasing allocator and trivially destructible T
+    //nodes are not visited at all, clear is O(chunks)
     void clear() {
-        for (size_t i = 0; i < m_levels.size(); i++)
-            _clear_lvl(i);
+        if constexpr (!(Alloc::bulk_release && std::is_trivially_destructible_v<T>)){
+            for (Node* it = m_levels[0].next; it;){
+                Node* next = it->_link(0);
+                if constexpr (Alloc::bulk_release)
+                    it->~Node();
+                else _free_node(it);
+                it = next;
+            }
+        }
+
+        m_alloc.reset();
+        m_levels.assign(1, Link{});
+        m_size = 0;
+        m_dead = 0;
+        m_finger_levels = 0;
+    }
+
+    bool empty() const { return !size(); }
+
+    //number of elements, tombstones are not counted
+    size_t size() const { return m_size - m_dead; }
+
+    //tombstones waiting for compact()
+    size_t tombstones() const { return m_dead; }
+
+    //in lazy mode remove marks node as tombstone instead of unlinking it,
+    //so it costs one search and no allocator work; tombstones are freed
+    //by compact(), which runs by itself once they make compact_ratio of
+    //all nodes (1 leaves it to the caller only)
+    //positional operations (rank, select, erase_at, split_at, concat)
+    //compact first; switching lazy mode off compacts too
+    void set_lazy(bool lazy, double compact_ratio = 0.5) {
+        if (!(compact_ratio > 0 && compact_ratio <= 1))
+            throw std::invalid_argument("SkipList: compact ratio must be in (0, 1]");
+
+        m_lazy = lazy;
+        m_compact_ratio = compact_ratio;
+
+        if (!lazy)
+            compact();
     }
 
-    bool empty() { return m_levels[0]; }
+    bool lazy() const { return m_lazy; }
+
+    //unlinks and frees all tombstones in one pass over level 0
+    void compact() {
+        if (!m_dead)
+            return;
+
+        //last live node on every level and its new position
+        Node* tails[MaxLevels]{};
+        size_t tail_rank[MaxLevels]{};
+        size_t pos = 0;
+
+        for (Node* it = m_levels[0].next; it;){
+            Node* next = it->_link(0);
+
+            if (it->_dead){
+                _free_node(it);
+            } else {
+                pos++;
+                it->_prev = tails[0];
+
+                for (size_t lvl = 0; lvl < it->_height; lvl++){
+                    _at(tails[lvl], lvl) = {it, pos - tail_rank[lvl]};
+                    tails[lvl] = it;
+                    tail_rank[lvl] = pos;
+                }
+            }
+
+            it = next;
+        }
+
+        for (size_t lvl = 0; lvl < m_levels.size(); lvl++)
+            _at(tails[lvl], lvl) = {nullptr, pos - tail_rank[lvl]};
+
+        m_size = pos;
+        m_dead = 0;
+        m_finger_levels = 0;
+        _shrink();
+    }
 
     void remove(T val) {
-        Node* res = _search(val);
-        _remove(res);
+        Node* update[MaxLevels];
+        Node* res = _search(val, m_lazy ? nullptr : update);
+
+        if (!m_lazy){
+            _remove(res, update);
+            return;
+        }
+
+        if (!res)
+            return;
+
+        res->_dead = true;
+        m_dead++;
+
+        if (m_dead > m_size * m_compact_ratio)
+            compact();
     }
 
+    //search starts from the last insert position, so ascending keys are
+    //appended in O(1) amortized and keys slightly out of order cost O(log d)
     iterator insert(T val) {
-        auto head = _insert_at(0, val, nullptr);
-        Node* n = head;
+        Node* update[MaxLevels];
+        size_t rank[MaxLevels];
+        _finger_bound(val, update, rank, true);
+
+        size_t height = _random_height();
+        _grow(height, update, rank);
 
-        for (int lvl = 1;coin_flip() && (lvl < static_cast<int>(m_levels.size())) ;lvl++){
-            n = _insert_at(lvl, val, n);
+        return iterator(_link_node(_make_node(std::move(val), height), update, rank));
+    }
+
+    //inserts sorted batch element by element through the finger: search
+    //for each one climbs from the path of the previous one, O(log d) for
+    //d positions between them, so a dense batch costs few compares per
+    //element instead of a search from the head
+    //throws std::logic_error on unsorted input, elements before it stay
+    template<std::ranges::input_range R>
+    void insert_sorted(R&& range) {
+        bool first = true;
+
+        for (auto&& val : range){
+            if (!first && m_comp(val, m_finger[0]->_data))
+                throw std::logic_error("insert_sorted: range is not sorted");
+
+            insert(val);
+            first = false;
+        }
+    }
+
+    //insert only if no equal value is present
+    //returns position of inserted or already present value
+    std::pair<iterator, bool> insert_unique(T val) {
+        if (m_finger_levels && !m_finger[0]->_dead && !m_comp(val, m_finger[0]->_data) && !m_comp(m_finger[0]->_data, val))
+            return {iterator(m_finger[0]), false};
+
+        Node* update[MaxLevels];
+        size_t rank[MaxLevels];
+        Node* res = _finger_bound(val, update, rank);
+        Node* live = _live(res);
+
+        if (live && !m_comp(val, live->_data))
+            return {iterator(live), false};
+
+        //tombstone of the same value is brought back instead of new node
+        if (res && res->_dead && !m_comp(val, res->_data)){
+            res->_dead = false;
+            m_dead--;
+            return {iterator(res), true};
         }
 
-        return iterator(head);
+        size_t height = _random_height();
+        _grow(height, update, rank);
+
+        return {iterator(_link_node(_make_node(std::move(val), height), update, rank)), true};
     }
 
-    iterator find(T val) {
-        Node* res = _search(val);
+    //moves all elements not less than key to returned list
+    //only links crossing the boundary are rewired, O(log n)
+    //nodes change owner, so it is not available for bulk releasing allocators
+    template<typename K = T>
+    SkipList split_at(const K& key) requires (!Alloc::bulk_release) {
+        compact();
+
+        Node* update[MaxLevels];
+        size_t rank[MaxLevels];
+        _lower_bound(key, update, rank);
+
+        SkipList res = _empty_like();
+        size_t keep = rank[0];
+        res.m_levels.resize(m_levels.size());
+
+        for (size_t lvl = 0; lvl < m_levels.size(); lvl++){
+            Link& link = _at(update[lvl], lvl);
+            res.m_levels[lvl] = {link.next, rank[lvl] + link.span - keep};
+            link = {nullptr, keep - rank[lvl]};
+        }
+
+        if (res.m_levels[0].next)
+            res.m_levels[0].next->_prev = nullptr;
+
+        res.m_size = m_size - keep;
+        m_size = keep;
+        m_finger_levels = 0;
 
-        for (;res->_bottom; res = res->_bottom);
+        _shrink();
+        res._shrink();
+        return res;
+    }
+
+    //appends all elements of other, they must not be less than last element
+    //only links crossing the boundary are rewired, O(log n)
+    void concat(SkipList& other) requires (!Alloc::bulk_release) {
+        compact();
+        other.compact();
+
+        if (other.empty())
+            return;
+
+        Node* update[MaxLevels];
+        size_t rank[MaxLevels];
+        _descend([](const T&){ return true; }, update, rank);
+
+        if (update[0] && m_comp(other.m_levels[0].next->_data, update[0]->_data))
+            throw std::logic_error("concat: ranges overlap");
+
+        _grow(other.m_levels.size(), update, rank);
+
+        for (size_t lvl = 0; lvl < m_levels.size(); lvl++){
+            Link& link = _at(update[lvl], lvl);
+
+            if (lvl < other.m_levels.size()){
+                link.next = other.m_levels[lvl].next;
+                link.span += other.m_levels[lvl].span;
+            } else link.span += other.m_size;
+        }
+
+        other.m_levels[0].next->_prev = update[0];
+
+        m_size += other.m_size;
+        m_finger_levels = 0;
+
+        other.m_levels.assign(1, Link{});
+        other.m_size = 0;
+        other.m_finger_levels = 0;
+    }
+
+    //unlinks first element equal to key and hands its node over,
+    //empty handle if there is no such element
+    //node handles outlive the list, so it is not available for bulk releasing allocators
+    template<typename K = T>
+    NodeHandle extract(const K& key) requires (!Alloc::bulk_release) {
+        return extract(iterator(_search(key)));
+    }
+
+    NodeHandle extract(iterator pos) requires (!Alloc::bulk_release) {
+        if (!pos)
+            return {};
+
+        Node* update[MaxLevels];
+        _path_to(pos.m_ptr, update);
+        _unlink(pos.m_ptr, pos.m_ptr->_link(0), update, false);
+
+        return NodeHandle(pos.m_ptr);
+    }
+
+    //links node of the handle, its tower height is kept
+    //returns end() for empty handle
+    iterator insert(NodeHandle&& nh) requires (!Alloc::bulk_release) {
+        if (!nh)
+            return end();
+
+        Node* n = std::exchange(nh.m_node, nullptr);
+        n->_dead = false;
+
+        Node* update[MaxLevels];
+        size_t rank[MaxLevels];
+        _finger_bound(n->_data, update, rank);
+        _grow(n->_height, update, rank);
+
+        return iterator(_link_node(n, update, rank));
+    }
+
+    //moves every element of other here, nodes are relinked, not copied
+    //other is left empty; when other goes after the last element it is
+    //concat(), otherwise nodes are taken in order, so every one is found
+    //from the finger of the previous one
+    void merge(SkipList& other) requires (!Alloc::bulk_release) {
+        if (this == &other || other.empty())
+            return;
+
+        Node* update[MaxLevels];
+        _descend([](const T&){ return true; }, update);
+        Node* first = _live(other.m_levels[0].next);
+
+        if (!update[0] || (first && !m_comp(first->_data, update[0]->_data))){
+            concat(other);
+            return;
+        }
+
+        Node* it = other.m_levels[0].next;
+        other.m_levels.assign(1, Link{});
+        other.m_size = other.m_dead = other.m_finger_levels = 0;
+
+        for (;it;){
+            Node* next = it->_link(0);
+
+            if (it->_dead)
+                other._free_node(it);
+            else insert(NodeHandle(it));
+
+            it = next;
+        }
+    }
+
+    //removes node at pos, returns iterator to the next one
+    iterator erase(iterator pos) {
+        return erase(pos, std::next(pos));
+    }
+
+    //removes [first, last), only the boundary is searched
+    iterator erase(iterator first, iterator last) {
+        if (first == last)
+            return last;
+
+        Node* update[MaxLevels];
+        _path_to(first.m_ptr, update);
+        _unlink(first.m_ptr, last.m_ptr, update);
+
+        return last;
+    }
+
+    //number of elements less than key, it is position of lower_bound(key)
+    template<typename K = T>
+    size_t rank(const K& key) {
+        compact();
+
+        size_t pos[MaxLevels];
+        _lower_bound(key, nullptr, pos);
+        return pos[0];
+    }
+
+    //element at position k, end() if k is out of range
+    iterator select(size_t k) {
+        compact();
+        return iterator(k < m_size ? _select(k) : nullptr);
+    }
+
+    //cuts list into parts ranges of equal size (+-1), returns parts + 1
+    //boundaries from begin() to end(); every cut is found through upper
+    //levels with spans, O(parts * log n), level 0 is not walked
+    std::vector<iterator> partition(size_t parts) {
+        compact();
+        parts = std::clamp<size_t>(parts, 1, std::max<size_t>(m_size, 1));
+
+        std::vector<iterator> res;
+        res.reserve(parts + 1);
+        res.push_back(begin());
+
+        for (size_t i = 1; i < parts; i++)
+            res.push_back(iterator(_select(i * m_size / parts)));
+
+        res.push_back(end());
+        return res;
+    }
+
+    T& operator[](size_t k) {
+        compact();
+
+        if (k >= m_size)
+            throw std::out_of_range("SkipList: index out of range");
+
+        return _select(k)->_data;
+    }
+
+    //removes element at position k, returns iterator to the next one
+    iterator erase_at(size_t k) {
+        compact();
+
+        if (k >= m_size)
+            return end();
+
+        Node* update[MaxLevels];
+        Node* res = _select(k, update);
+        Node* next = res->_link(0);
+        _remove(res, update);
+
+        return iterator(next);
+    }
+
+    //keys of any type Compare accepts together with T are looked up as is
+    template<typename K = T>
+    iterator find(const K& val) {
+        return iterator(_search(val));
+    }
+
+    //batched find: writes iterator (end() if missing) for every key to out
+    //in order of keys; hides memory latency of one search behind the others
+    template<std::ranges::forward_range R, std::output_iterator<iterator> Out>
+    Out find_many(const R& keys, Out out) {
+        Node* res[BatchGroup];
+        auto it = std::ranges::begin(keys);
+        auto last = std::ranges::end(keys);
+
+        for (;it != last;){
+            auto group = it;
+            size_t cnt = 0;
+            for (;cnt < BatchGroup && it != last; ++it, cnt++);
+
+            _lower_bound_group(group, cnt, res);
+
+            for (size_t i = 0; i < cnt; i++, ++group)
+                *out++ = iterator(_live_equal(res[i], *group));
+        }
+
+        return out;
+    }
+
+    //batched contains, writes one bool per key to out
+    template<std::ranges::forward_range R, std::output_iterator<bool> Out>
+    Out contains_many(const R& keys, Out out) {
+        Node* res[BatchGroup];
+        auto it = std::ranges::begin(keys);
+        auto last = std::ranges::end(keys);
+
+        for (;it != last;){
+            auto group = it;
+            size_t cnt = 0;
+            for (;cnt < BatchGroup && it != last; ++it, cnt++);
+
+            _lower_bound_group(group, cnt, res);
+
+            for (size_t i = 0; i < cnt; i++, ++group)
+                *out++ = _live_equal(res[i], *group);
+        }
+
+        return out;
+    }
+
+    template<typename K = T>
+    bool contains(const K& val) {
+        return _search(val);
+    }
+
+    //first element not less than key
+    template<typename K = T>
+    iterator lower_bound(const K& key) {
+        return iterator(_live(_lower_bound(key)));
+    }
+
+    //first element greater than key
+    template<typename K = T>
+    iterator upper_bound(const K& key) {
+        return iterator(_live(_upper_bound(key)));
+    }
 
-        return iterator(res);
+    //range of elements equal to key, both ends by descent, O(log n) for any run of equal keys
+    template<typename K = T>
+    std::pair<iterator, iterator> equal_range(const K& key) {
+        return {lower_bound(key), upper_bound(key)};
     }
 
     std::string to_string(int lvl = 0) {
         std::stringstream ss;
 
         ss << "[";
-        for (Node* it = m_levels[lvl]; it; it = it->_next){
+        for (Node* it = m_levels[lvl].next; it; it = it->_link(lvl)){
             ss << it->_data;
 
-            if (it->_next)
+            if (it->_link(lvl))
                 ss << ", ";
         }
 
@@ -257,10 +1150,10 @@ public:
         return ss.str();
     }
 
-    iterator begin() { return iterator(m_levels[0]); }
+    iterator begin() { return iterator(_live(m_levels[0].next)); }
     iterator end() { return iterator(nullptr); }
-    const_iterator cbegin() { return const_iterator(m_levels[0]); };
-    const_iterator cend() { return const_iterator(nullptr); }
+    const_iterator cbegin() { return begin(); }
+    const_iterator cend() { return end(); }
 
 };
 
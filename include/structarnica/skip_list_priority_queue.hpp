@@ -0,0 +1,261 @@
+#ifndef SKIP_LIST_PRIORITY_QUEUE_HPP
+#define SKIP_LIST_PRIORITY_QUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <random>
+#include <thread>
+#include <structarnica/epoch.hpp>
+#include <structarnica/striped_counter.hpp>
+
+namespace DS {
+
+//lock-free priority queue (Lindén, Jonsson) on top of skip list
+//pop_min deletes logically by setting the low bit of level 0 pointer to
+//the node, so deleted nodes form a prefix of the list and pops just walk
+//it with fetch_or; the prefix is unlinked from the head in one CAS only
+//once it is bound_offset nodes long, and unlinked nodes are reclaimed
+//through DS::Epoch; equal keys are popped in push order
+template<typename T>
+class SkipListPriorityQueue {
+
+public:
+
+    static constexpr size_t MaxLevels = 32;
+
+private:
+
+    using Link = std::atomic<uintptr_t>;
+
+    struct Node {
+
+        Node(const T& val, size_t height):_data{val}, _height{height} {}
+
+        Link* _links() { return reinterpret_cast<Link*>(this + 1); }
+
+        Link& _link(size_t lvl) { return _links()[lvl]; }
+
+        T _data;
+        size_t _height;
+        //set while upper levels are being linked, such node and everything
+        //after it is kept by head unlinking
+        std::atomic<bool> _inserting{true};
+    };
+
+    static_assert(sizeof(Node) % alignof(Link) == 0, "forward pointers must be aligned");
+
+    //marked pointer on level 0 means the node it points to is deleted
+    //upper level pointers are never marked
+    Link m_head[MaxLevels];
+    //pushes and pops of a thread go to its own stripe, pops already meet
+    //at the head, they do not meet on the counter too
+    StripedCounter m_size;
+    size_t m_bound_offset;
+
+    static Node* _ptr(uintptr_t link) { return reinterpret_cast<Node*>(link & ~uintptr_t(1)); }
+
+    static bool _marked(uintptr_t link) { return link & 1; }
+
+    static uintptr_t _pack(Node* n, bool mark = false) { return reinterpret_cast<uintptr_t>(n) | uintptr_t(mark); }
+
+    static Node* _make_node(const T& val, size_t height) {
+        void* mem = ::operator new(sizeof(Node) + height * sizeof(Link));
+        Node* n = ::new (mem) Node(val, height);
+        for (size_t i = 0; i < height; i++)
+            ::new (&n->_link(i)) Link(0);
+        return n;
+    }
+
+    static void _free_node(void* ptr) {
+        Node* n = static_cast<Node*>(ptr);
+        for (size_t i = 0; i < n->_height; i++)
+            n->_link(i).~Link();
+        n->~Node();
+        ::operator delete(n);
+    }
+
+    //nullptr stands for the head
+    Link& _next(Node* prev, size_t lvl) {
+        return prev ? prev->_link(lvl) : m_head[lvl];
+    }
+
+    //node is deleted when pointer to its successor is marked
+    static bool _dead_before(Node* n) {
+        return n && _marked(n->_link(0).load());
+    }
+
+    //every thread draws levels from its own generator
+    static size_t _random_height() {
+        thread_local std::mt19937_64 rng(std::random_device{}() ^ std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        return std::min<size_t>(std::countr_zero(rng() | (uint64_t(1) << 63)) + 1, MaxLevels);
+    }
+
+    //fills preds and succs, deleted prefix counts as less than everything
+    //so new nodes always go after it; returns last deleted node passed on level 0
+    Node* _locate_preds(const T& val, Node** preds, Node** succs) {
+        Node* pred = nullptr;
+        Node* del = nullptr;
+
+        for (size_t lvl = MaxLevels; lvl--;){
+            uintptr_t raw = _next(pred, lvl).load();
+            bool dead = _marked(raw);
+            Node* cur = _ptr(raw);
+
+            for (;cur && (!(val < cur->_data) || _dead_before(cur) || (!lvl && dead));){
+                if (!lvl && dead)
+                    del = cur;
+
+                pred = cur;
+                raw = pred->_link(lvl).load();
+                dead = _marked(raw);
+                cur = _ptr(raw);
+            }
+
+            preds[lvl] = pred;
+            succs[lvl] = cur;
+        }
+
+        return del;
+    }
+
+    //moves head upper levels past the deleted prefix
+    void _restructure() {
+        Node* pred = nullptr;
+
+        for (size_t lvl = MaxLevels - 1; lvl > 0;){
+            uintptr_t h = m_head[lvl].load();
+
+            if (!_dead_before(_ptr(h))){
+                lvl--;
+                continue;
+            }
+
+            uintptr_t cur = _next(pred, lvl).load();
+            for (;_dead_before(_ptr(cur)); cur = pred->_link(lvl).load())
+                pred = _ptr(cur);
+
+            if (m_head[lvl].compare_exchange_strong(h, cur))
+                lvl--;
+        }
+    }
+
+public:
+
+    //bound_offset is how long deleted prefix grows before it is unlinked,
+    //bigger value means fewer CAS on the head
+    explicit SkipListPriorityQueue(size_t bound_offset = 32):m_bound_offset{bound_offset} {
+        for (auto& l : m_head)
+            l.store(0);
+    }
+
+    SkipListPriorityQueue(const SkipListPriorityQueue&) = delete;
+
+    SkipListPriorityQueue& operator=(const SkipListPriorityQueue&) = delete;
+
+    //must not race with other operations
+    ~SkipListPriorityQueue() {
+        for (Node* it = _ptr(m_head[0].load()); it;){
+            Node* next = _ptr(it->_link(0).load());
+            _free_node(it);
+            it = next;
+        }
+    }
+
+    void push(const T& val) {
+        auto guard = Epoch::pin();
+        Node* preds[MaxLevels];
+        Node* succs[MaxLevels];
+        Node* n = _make_node(val, _random_height());
+        Node* del;
+
+        for (;;){
+            del = _locate_preds(val, preds, succs);
+            n->_link(0).store(_pack(succs[0]), std::memory_order_relaxed);
+
+            uintptr_t expected = _pack(succs[0]);
+            if (_next(preds[0], 0).compare_exchange_strong(expected, _pack(n)))
+                break;
+        }
+
+        m_size.add(1);
+
+        for (size_t lvl = 1; lvl < n->_height;){
+            n->_link(lvl).store(_pack(succs[lvl]));
+
+            //node or its successor got popped, upper levels are not worth it
+            if (_dead_before(n) || _dead_before(succs[lvl]) || (del && del == succs[lvl]))
+                break;
+
+            uintptr_t expected = _pack(succs[lvl]);
+            if (_next(preds[lvl], lvl).compare_exchange_strong(expected, _pack(n))){
+                lvl++;
+                continue;
+            }
+
+            del = _locate_preds(val, preds, succs);
+            if (succs[0] != n)
+                break;
+        }
+
+        n->_inserting.store(false);
+    }
+
+    //removes the smallest element, nullopt if queue is empty
+    std::optional<T> pop_min() {
+        auto guard = Epoch::pin();
+        uintptr_t observed = m_head[0].load();
+        Node* x = nullptr;
+        Node* new_head = nullptr;
+        size_t offset = 0;
+
+        for (uintptr_t next;;){
+            if (!_ptr(_next(x, 0).load()))
+                return std::nullopt;
+
+            if (x && !new_head && x->_inserting.load())
+                new_head = x;
+
+            next = _next(x, 0).fetch_or(1);
+            offset++;
+            x = _ptr(next);
+
+            if (!_marked(next))
+                break;
+        }
+
+        m_size.add(-1);
+        std::optional<T> res{x->_data};
+
+        if (offset < m_bound_offset)
+            return res;
+
+        if (!new_head)
+            new_head = x;
+
+        //one thread unlinks the whole prefix before new_head
+        if (m_head[0].compare_exchange_strong(observed, _pack(new_head, true))){
+            _restructure();
+
+            for (Node* it = _ptr(observed); it != new_head;){
+                Node* next = _ptr(it->_link(0).load());
+                Epoch::retire(it, &_free_node);
+                it = next;
+            }
+        }
+
+        return res;
+    }
+
+    size_t size() const { return m_size.value(); }
+
+    bool empty() const { return !size(); }
+
+};
+
+} //DS namespace
+
+#endif //SKIP_LIST_PRIORITY_QUEUE_HPP
@@ -0,0 +1,99 @@
+#ifndef SKIP_MAP_HPP
+#define SKIP_MAP_HPP
+
+#include <utility>
+#include <structarnica/skip_list.hpp>
+
+namespace DS {
+
+//ordered key/value map on top of SkipList
+//entries are ordered by key only, every key is stored once
+//seeks go through upper levels in O(log n), scans continue on level 0
+template<typename K, typename V>
+class SkipMap {
+
+public:
+
+    struct Entry {
+
+        const K first;
+        V second;
+
+        friend bool operator<(const Entry& a, const Entry& b) { return a.first < b.first; }
+
+        friend bool operator<(const Entry& a, const K& key) { return a.first < key; }
+
+        friend bool operator<(const K& key, const Entry& a) { return key < a.first; }
+    };
+
+    using value_type = Entry;
+    using iterator = typename SkipList<Entry>::iterator;
+
+    SkipMap(size_t max_levels = SkipList<Entry>::MaxLevels, double p = 0.5):m_list(max_levels, p) {}
+
+    //returns position of key and true if it was inserted
+    std::pair<iterator, bool> insert(const K& key, const V& val) {
+        return m_list.insert_unique(Entry{key, val});
+    }
+
+    //inserts or overwrites value of key
+    iterator insert_or_assign(const K& key, const V& val) {
+        auto [it, inserted] = m_list.insert_unique(Entry{key, val});
+
+        if (!inserted)
+            it->second = val;
+
+        return it;
+    }
+
+    V& operator[](const K& key) {
+        return m_list.insert_unique(Entry{key, V{}}).first->second;
+    }
+
+    iterator find(const K& key) { return m_list.find(key); }
+
+    bool contains(const K& key) { return m_list.contains(key); }
+
+    std::optional<V> get(const K& key) {
+        auto it = m_list.find(key);
+        return it ? std::optional<V>{it->second} : std::nullopt;
+    }
+
+    iterator lower_bound(const K& key) { return m_list.lower_bound(key); }
+
+    iterator upper_bound(const K& key) { return m_list.upper_bound(key); }
+
+    std::pair<iterator, iterator> equal_range(const K& key) { return m_list.equal_range(key); }
+
+    bool erase(const K& key) {
+        auto it = m_list.find(key);
+
+        if (!it)
+            return false;
+
+        m_list.erase(it);
+        return true;
+    }
+
+    iterator erase(iterator pos) { return m_list.erase(pos); }
+
+    iterator erase(iterator first, iterator last) { return m_list.erase(first, last); }
+
+    void clear() { m_list.clear(); }
+
+    bool empty() const { return m_list.empty(); }
+
+    size_t size() const { return m_list.size(); }
+
+    iterator begin() { return m_list.begin(); }
+    iterator end() { return m_list.end(); }
+
+private:
+
+    SkipList<Entry> m_list;
+
+};
+
+} //DS namespace
+
+#endif //SKIP_MAP_HPP
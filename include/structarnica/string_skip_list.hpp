@@ -0,0 +1,324 @@
+#ifndef STRING_SKIP_LIST_HPP
+#define STRING_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DS {
+
+//ordered set of byte strings
+//key bytes live in the node right after its forward links, so a compare
+//never follows a pointer to a separate heap buffer
+//bytes shared by every key ("https://" of urls) decide nothing, so 16 bytes
+//after this common prefix are kept as two big endian integers, compares of
+//keys that differ in host or first part of path end on them; common prefix
+//only shrinks, every shrink rewrites integers of all nodes in O(n)
+//lookups take std::string_view, nothing is copied to search
+class StringSkipList {
+
+public:
+
+    static constexpr size_t MaxLevels = 32;
+    static constexpr size_t PrefixBytes = 2 * sizeof(uint64_t);
+
+private:
+
+    //compared as one 128 bit integer
+    using Prefix = std::array<uint64_t, 2>;
+
+    struct Node {
+
+        Prefix _prefix;
+        uint32_t _len;
+        uint32_t _height;
+
+        Node** _links() { return reinterpret_cast<Node**>(this + 1); }
+
+        Node*& _link(size_t lvl) { return _links()[lvl]; }
+
+        const char* _bytes() const {
+            return reinterpret_cast<const char*>(this + 1) + _height * sizeof(Node*);
+        }
+
+        std::string_view _key() const { return {_bytes(), _len}; }
+    };
+
+    //search key with its prefix computed once
+    struct Probe {
+        std::string_view key;
+        Prefix prefix;
+        //-1 or 1 if key is less or greater than every key of the list
+        int side;
+    };
+
+    std::vector<Node*> m_levels;
+    size_t m_size{0};
+    //bytes every key starts with
+    std::string m_common;
+    std::mt19937_64 m_rng{std::random_device{}()};
+
+#ifdef DS_DEBUG_STRING_SKIP_LIST
+    size_t m_compares{0};
+    size_t m_prefix_compares{0};
+#endif
+
+    //byte order of prefix integers is byte order of strings,
+    //shorter keys are padded with zeros
+    Prefix _prefix(std::string_view key) const {
+        Prefix res{};
+        size_t skip = m_common.size();
+        size_t cnt = key.size() > skip ? std::min(key.size() - skip, PrefixBytes) : 0;
+
+        for (size_t i = 0; i < cnt; i++)
+            res[i / 8] |= uint64_t(static_cast<unsigned char>(key[skip + i])) << (56 - 8 * (i % 8));
+
+        return res;
+    }
+
+    //length of common part of key and common prefix
+    size_t _shared(std::string_view key) const {
+        size_t cnt = std::min(key.size(), m_common.size());
+        return std::mismatch(key.begin(), key.begin() + cnt, m_common.begin()).first - key.begin();
+    }
+
+    //key that does not start with common prefix is ordered by first byte that differs
+    Probe _probe(std::string_view key) const {
+        size_t shared = _shared(key);
+
+        if (shared == m_common.size())
+            return {key, _prefix(key), 0};
+
+        bool less = shared == key.size() || static_cast<unsigned char>(key[shared]) < static_cast<unsigned char>(m_common[shared]);
+        return {key, {}, less ? -1 : 1};
+    }
+
+    //common prefix is cut to len bytes, prefixes of nodes move back with it
+    void _shrink(size_t len) {
+        m_common.resize(len);
+
+        for (Node* it = m_levels[0]; it; it = it->_link(0))
+            it->_prefix = _prefix(it->_key());
+    }
+
+    //node key <=> probe key
+    int _compare(const Node* n, const Probe& p) {
+#ifdef DS_DEBUG_STRING_SKIP_LIST
+        m_compares++;
+        m_prefix_compares += p.side || n->_prefix != p.prefix;
+#endif
+        if (p.side)
+            return -p.side;
+
+        if (n->_prefix != p.prefix)
+            return n->_prefix < p.prefix ? -1 : 1;
+
+        //equal prefixes of keys not shorter than prefix are equal bytes
+        size_t skip = m_common.size() + PrefixBytes;
+        if (n->_len >= skip && p.key.size() >= skip)
+            return n->_key().substr(skip).compare(p.key.substr(skip));
+
+        return n->_key().compare(p.key);
+    }
+
+    static Node* _make_node(std::string_view key, const Prefix& prefix, size_t height) {
+        void* mem = ::operator new(sizeof(Node) + height * sizeof(Node*) + key.size());
+        Node* n = ::new (mem) Node{prefix, static_cast<uint32_t>(key.size()), static_cast<uint32_t>(height)};
+        std::uninitialized_value_construct_n(n->_links(), height);
+        std::memcpy(const_cast<char*>(n->_bytes()), key.data(), key.size());
+        return n;
+    }
+
+    static void _free_node(Node* n) {
+        ::operator delete(n);
+    }
+
+    Node*& _next(Node* prev, size_t lvl) {
+        return prev ? prev->_link(lvl) : m_levels[lvl];
+    }
+
+    size_t _random_height() {
+        size_t height = std::countr_zero(m_rng() | (uint64_t(1) << 63)) + 1;
+        size_t cap = std::bit_width(m_size + 1) + 1;
+        return std::min({height, cap, MaxLevels});
+    }
+
+    //first node not less than key, update gets last node before it on every level
+    Node* _lower_bound(const Probe& p, Node** update = nullptr) {
+        Node* prev = nullptr;
+
+        for (size_t lvl = m_levels.size(); lvl--;){
+            for (Node* n; (n = _next(prev, lvl)) && _compare(n, p) < 0; prev = n);
+
+            if (update)
+                update[lvl] = prev;
+        }
+
+        return _next(prev, 0);
+    }
+
+    Node* _search(std::string_view key, Node** update = nullptr) {
+        Probe p = _probe(key);
+        Node* res = _lower_bound(p, update);
+        return res && !_compare(res, p) ? res : nullptr;
+    }
+
+public:
+
+    //to support STL Iterator works on level 0
+    struct Iterator {
+
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::string_view;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        Iterator() = default;
+
+        explicit Iterator(Node* ptr):m_ptr{ptr} {}
+
+        reference operator*() const { return m_ptr->_key(); }
+
+        Iterator& operator++() {
+            m_ptr = m_ptr->_link(0);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return m_ptr == other.m_ptr; }
+
+        bool operator!=(const Iterator& other) const { return m_ptr != other.m_ptr; }
+
+        operator bool() const { return m_ptr; }
+
+    private:
+
+        Node* m_ptr{nullptr};
+    };
+
+    using iterator = Iterator;
+
+    StringSkipList():m_levels(1, nullptr) {}
+
+    StringSkipList(const StringSkipList&) = delete;
+
+    StringSkipList& operator=(const StringSkipList&) = delete;
+
+    ~StringSkipList() { clear(); }
+
+    void clear() {
+        for (Node* it = m_levels[0]; it;){
+            Node* next = it->_link(0);
+            _free_node(it);
+            it = next;
+        }
+
+        m_levels.assign(1, nullptr);
+        m_size = 0;
+        m_common.clear();
+    }
+
+    bool empty() const { return !m_size; }
+
+    size_t size() const { return m_size; }
+
+    //returns position of key and false if it was already there
+    std::pair<iterator, bool> insert(std::string_view key) {
+        Node* update[MaxLevels];
+
+        if (!m_size)
+            m_common = key;
+
+        //key out of common prefix is new, it is placed after the shrink
+        Probe p = _probe(key);
+        if (p.side){
+            _shrink(_shared(key));
+            p = _probe(key);
+        }
+
+        Node* res = _lower_bound(p, update);
+
+        if (res && !_compare(res, p))
+            return {iterator(res), false};
+
+        size_t height = _random_height();
+        for (size_t lvl = m_levels.size(); lvl < height; lvl++){
+            m_levels.push_back(nullptr);
+            update[lvl] = nullptr;
+        }
+
+        Node* n = _make_node(key, p.prefix, height);
+        for (size_t lvl = 0; lvl < height; lvl++){
+            Node*& link = _next(update[lvl], lvl);
+            n->_link(lvl) = link;
+            link = n;
+        }
+
+        m_size++;
+        return {iterator(n), true};
+    }
+
+    //returns false if key is not present
+    bool remove(std::string_view key) {
+        Node* update[MaxLevels];
+        Node* res = _search(key, update);
+
+        if (!res)
+            return false;
+
+        for (size_t lvl = 0; lvl < res->_height; lvl++)
+            _next(update[lvl], lvl) = res->_link(lvl);
+
+        _free_node(res);
+        m_size--;
+
+        if (!m_size)
+            m_common.clear();
+
+        for (;m_levels.size() > 1 && !m_levels.back(); m_levels.pop_back());
+        return true;
+    }
+
+    iterator find(std::string_view key) { return iterator(_search(key)); }
+
+    bool contains(std::string_view key) { return _search(key); }
+
+    //first key not less than key
+    iterator lower_bound(std::string_view key) {
+        return iterator(_lower_bound(_probe(key)));
+    }
+
+    iterator begin() { return iterator(m_levels[0]); }
+    iterator end() { return iterator(nullptr); }
+
+    //bytes every key starts with
+    std::string_view common_prefix() const { return m_common; }
+
+#ifdef DS_DEBUG_STRING_SKIP_LIST
+
+    //compares made and those decided without reading key bytes
+    size_t compares() const { return m_compares; }
+    size_t prefix_compares() const { return m_prefix_compares; }
+
+#endif
+
+};
+
+} //DS namespace
+
+#endif //STRING_SKIP_LIST_HPP
@@ -0,0 +1,51 @@
+#ifndef STRIPED_COUNTER_HPP
+#define STRIPED_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace DS {
+
+//element counter of lock-free structures: every thread adds to its own
+//stripe on a separate cache line, so writers do not fight for one word
+//value() sums stripes, it is exact when no add runs at the same time
+class StripedCounter {
+
+public:
+
+    static constexpr size_t Stripes = 64;
+
+    void add(std::ptrdiff_t d) {
+        m_stripes[_stripe()].count.fetch_add(d, std::memory_order_relaxed);
+    }
+
+    //erase counted on other stripe before its insert can make sum negative
+    size_t value() const {
+        std::ptrdiff_t res = 0;
+
+        for (auto& s : m_stripes)
+            res += s.count.load(std::memory_order_relaxed);
+
+        return res > 0 ? res : 0;
+    }
+
+private:
+
+    struct alignas(64) Stripe {
+        std::atomic<std::ptrdiff_t> count{0};
+    };
+
+    //threads take stripes round robin on first use
+    static size_t _stripe() {
+        static std::atomic<size_t> next{0};
+        thread_local size_t idx = next.fetch_add(1, std::memory_order_relaxed) % Stripes;
+        return idx;
+    }
+
+    Stripe m_stripes[Stripes];
+
+};
+
+} //DS namespace
+
+#endif //STRIPED_COUNTER_HPP
@@ -0,0 +1,337 @@
+#ifndef UNROLLED_SKIP_LIST_HPP
+#define UNROLLED_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace DS {
+
+//unrolled skip list for small trivially copyable keys
+//level 0 is a chain of sorted blocks, every block holds up to Capacity keys
+//in BlockBytes of memory; upper levels index blocks by their first key
+//search inside block is branch free count of smaller keys
+//full block is split in half, nearly empty block is merged with the next one
+template<typename T, size_t BlockBytes = 128>
+requires std::is_trivially_copyable_v<T> && std::totally_ordered<T>
+class UnrolledSkipList {
+
+public:
+
+    static constexpr size_t MaxLevels = 32;
+    static constexpr size_t Capacity = std::max<size_t>(BlockBytes / sizeof(T), 4);
+    static constexpr size_t BlockAlign = 64;
+
+private:
+
+    struct Block {
+
+        //first member so keys start at cache line boundary
+        T _keys[Capacity];
+        Block* _prev{nullptr};
+        uint32_t _count{0};
+        uint32_t _height;
+
+        explicit Block(size_t height):_height{static_cast<uint32_t>(height)} {}
+
+        Block** _links() { return reinterpret_cast<Block**>(this + 1); }
+
+        Block*& _link(size_t lvl) { return _links()[lvl]; }
+
+        const T& _min() const { return _keys[0]; }
+
+        //number of keys less than key, compiles to vector compares
+        size_t _rank(const T& key) const {
+            size_t res = 0;
+            for (size_t i = 0; i < _count; i++)
+                res += _keys[i] < key;
+            return res;
+        }
+    };
+
+    static_assert(sizeof(Block) % alignof(Block*) == 0, "forward pointers must be aligned");
+
+    std::vector<Block*> m_levels;
+    size_t m_size{0};
+    size_t m_blocks{0};
+    std::mt19937_64 m_rng{std::random_device{}()};
+
+    static Block* _make_block(size_t height) {
+        void* mem = ::operator new(sizeof(Block) + height * sizeof(Block*), std::align_val_t{BlockAlign});
+        Block* b = ::new (mem) Block(height);
+        std::uninitialized_value_construct_n(b->_links(), height);
+        return b;
+    }
+
+    static void _free_block(Block* b) {
+        b->~Block();
+        ::operator delete(b, std::align_val_t{BlockAlign});
+    }
+
+    Block*& _next(Block* prev, size_t lvl) {
+        return prev ? prev->_link(lvl) : m_levels[lvl];
+    }
+
+    size_t _random_height() {
+        size_t height = std::countr_zero(m_rng() | (uint64_t(1) << 63)) + 1;
+        size_t cap = std::bit_width(m_blocks + 1) + 1;
+        return std::min({height, cap, MaxLevels});
+    }
+
+    //last block on every level whose first key is less than key
+    Block* _descend(const T& key, Block** update = nullptr) {
+        Block* prev = nullptr;
+
+        for (size_t lvl = m_levels.size(); lvl--;){
+            for (Block* b; (b = _next(prev, lvl)) && b->_min() < key; prev = b);
+
+            if (update)
+                update[lvl] = prev;
+        }
+
+        return prev;
+    }
+
+    //exact update path of block b
+    void _path_to(Block* b, Block** update) {
+        _descend(b->_min(), update);
+
+        for (Block* it = _next(update[0], 0); it != b; it = it->_link(0)){
+            for (size_t lvl = 0; lvl < it->_height; lvl++)
+                update[lvl] = it;
+        }
+    }
+
+    //links new block b right after update[0]
+    void _link_block(Block* b, Block** update) {
+        for (size_t lvl = m_levels.size(); lvl < b->_height; lvl++){
+            m_levels.push_back(nullptr);
+            update[lvl] = nullptr;
+        }
+
+        for (size_t lvl = 0; lvl < b->_height; lvl++){
+            Block*& link = _next(update[lvl], lvl);
+            b->_link(lvl) = link;
+            link = b;
+        }
+
+        b->_prev = update[0];
+        if (b->_link(0))
+            b->_link(0)->_prev = b;
+
+        m_blocks++;
+    }
+
+    void _unlink_block(Block* b) {
+        Block* update[MaxLevels];
+        _path_to(b, update);
+
+        for (size_t lvl = 0; lvl < b->_height; lvl++)
+            _next(update[lvl], lvl) = b->_link(lvl);
+
+        if (b->_link(0))
+            b->_link(0)->_prev = b->_prev;
+
+        _free_block(b);
+        m_blocks--;
+    }
+
+    //position of first key not less than key
+    std::pair<Block*, size_t> _lower_bound(const T& key) {
+        Block* b = _descend(key);
+
+        if (!b)
+            return {m_levels[0], 0};
+
+        size_t idx = b->_rank(key);
+        if (idx == b->_count)
+            return {b->_link(0), 0};
+
+        return {b, idx};
+    }
+
+public:
+
+    struct Iterator {
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() = default;
+
+        Iterator(Block* block, size_t idx):m_block{block}, m_idx{idx} {}
+
+        reference operator*() const { return m_block->_keys[m_idx]; }
+
+        pointer operator->() const { return &m_block->_keys[m_idx]; }
+
+        Iterator& operator++() {
+            if (++m_idx == m_block->_count){
+                m_block = m_block->_link(0);
+                m_idx = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        Iterator& operator--() {
+            if (!m_idx){
+                m_block = m_block->_prev;
+                m_idx = m_block->_count;
+            }
+            --m_idx;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator tmp(*this);
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return m_block == other.m_block && m_idx == other.m_idx; }
+
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+        operator bool() const { return m_block; }
+
+        friend UnrolledSkipList;
+
+    private:
+
+        Block* m_block{nullptr};
+        size_t m_idx{0};
+    };
+
+    using iterator = Iterator;
+
+    UnrolledSkipList():m_levels(1, nullptr) {}
+
+    UnrolledSkipList(const UnrolledSkipList&) = delete;
+
+    UnrolledSkipList& operator=(const UnrolledSkipList&) = delete;
+
+    ~UnrolledSkipList() { clear(); }
+
+    void clear() {
+        for (Block* it = m_levels[0]; it;){
+            Block* next = it->_link(0);
+            _free_block(it);
+            it = next;
+        }
+
+        m_levels.assign(1, nullptr);
+        m_size = 0;
+        m_blocks = 0;
+    }
+
+    bool empty() const { return !m_size; }
+
+    size_t size() const { return m_size; }
+
+    size_t blocks() const { return m_blocks; }
+
+    void insert(const T& key) {
+        Block* update[MaxLevels];
+        Block* b = _descend(key, update);
+
+        //key is less than every first key, it goes to the first block
+        if (!b){
+            b = m_levels[0];
+
+            if (!b){
+                b = _make_block(_random_height());
+                _link_block(b, update);
+            }
+        }
+
+        size_t idx = b->_rank(key);
+
+        if (b->_count == Capacity){
+            size_t half = Capacity / 2;
+            Block* right = _make_block(_random_height());
+
+            std::memcpy(right->_keys, b->_keys + half, (Capacity - half) * sizeof(T));
+            right->_count = Capacity - half;
+            b->_count = half;
+
+            //blocks after b on any level start with key or greater
+            //so the search path with b itself on its own levels fits right
+            for (size_t lvl = 0; lvl < b->_height; lvl++)
+                update[lvl] = b;
+            _link_block(right, update);
+
+            if (idx > half){
+                b = right;
+                idx -= half;
+            }
+        }
+
+        std::memmove(b->_keys + idx + 1, b->_keys + idx, (b->_count - idx) * sizeof(T));
+        b->_keys[idx] = key;
+        b->_count++;
+        m_size++;
+    }
+
+    bool remove(const T& key) {
+        auto [b, idx] = _lower_bound(key);
+
+        if (!b || b->_keys[idx] != key)
+            return false;
+
+        std::memmove(b->_keys + idx, b->_keys + idx + 1, (b->_count - idx - 1) * sizeof(T));
+        b->_count--;
+        m_size--;
+
+        if (!b->_count){
+            _unlink_block(b);
+            return true;
+        }
+
+        Block* next = b->_link(0);
+        if (next && b->_count < Capacity / 4 && b->_count + next->_count <= Capacity * 3 / 4){
+            std::memcpy(b->_keys + b->_count, next->_keys, next->_count * sizeof(T));
+            b->_count += next->_count;
+            _unlink_block(next);
+        }
+
+        return true;
+    }
+
+    iterator lower_bound(const T& key) {
+        auto [b, idx] = _lower_bound(key);
+        return iterator(b, idx);
+    }
+
+    iterator find(const T& key) {
+        auto [b, idx] = _lower_bound(key);
+        return b && b->_keys[idx] == key ? iterator(b, idx) : end();
+    }
+
+    bool contains(const T& key) {
+        return find(key) != end();
+    }
+
+    iterator begin() { return iterator(m_levels[0], 0); }
+    iterator end() { return iterator(nullptr, 0); }
+
+};
+
+} //DS namespace
+
+#endif //UNROLLED_SKIP_LIST_HPP
@@ -14,6 +14,14 @@
 #include <iostream>
 #include <string_view>
 #include <chrono>
+#include <type_traits>
+
+//hint to bring cache line of ptr in before it is read, no-op elsewhere
+#if defined(__GNUC__) || defined(__clang__)
+#define DS_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define DS_PREFETCH(ptr) ((void)(ptr))
+#endif
 
 namespace DS {
 
@@ -31,6 +39,7 @@ constexpr int32_t const_sum(const T arr[Size])
  * @brief print arrays
  * 
  * overload of 'operator<<' for ranges/arrays
+ * strings are ranges too, they are left to std overloads
  * 
  * @tparam T 
  * @param os std stream
@@ -38,7 +47,7 @@ constexpr int32_t const_sum(const T arr[Size])
  * @return std::ostream&
  */
 template<std::ranges::range T>
-requires std::ranges::range<T>
+requires (!std::is_convertible_v<const T&, std::string_view>)
 std::ostream& operator<<(std::ostream& os, T arr){
 
     unsigned i = 1;
@@ -0,0 +1,137 @@
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <structarnica/bplus_tree.hpp>
+
+using namespace std;
+using namespace DS;
+
+//comparator with non-const call operator, as in BST test
+template<typename T>
+struct Comp {
+    bool operator()(T a, T b){
+        return a < b;
+    }
+};
+
+template<typename Tree, typename Map>
+void check(Tree& tree, Map& ref) {
+    assert(tree.size() == ref.size());
+
+    auto it = ref.begin();
+    tree.inorder([&it]([[maybe_unused]] const auto& key, [[maybe_unused]] auto& val){
+        assert(key == it->first && val == it->second);
+        ++it;
+    });
+    assert(it == ref.end());
+}
+
+//nodes are not bigger than asked for and use most of it
+template<typename K, typename V, size_t Bytes>
+void check_layout() {
+    using Tree = BPlusTree<K, V, std::less<K>, Bytes>;
+    static_assert(Tree::LeafBytes <= Bytes && Tree::InnerBytes <= Bytes);
+    static_assert(Tree::LeafBytes + sizeof(K) + sizeof(V) > Bytes || Tree::LeafCapacity == 4);
+}
+
+int main() {
+
+    check_layout<int, int, 64>();
+    check_layout<int, int, 128>();
+    check_layout<int, int, 256>();
+    check_layout<uint64_t, uint64_t, 256>();
+    check_layout<double, char, 128>();
+    static_assert(BPlusTree<int, int, std::less<int>, 256>::LeafBytes == 256);
+
+    //small nodes give deep tree, every split and merge path is taken
+    BPlusTree<int, int, std::less<int>, 64> tree;
+    std::map<int, int> ref;
+    std::mt19937 gen(11);
+
+    for (int i = 0; i < 60000; i++){
+        [[maybe_unused]] int key = gen() % 5000;
+
+        if (gen() % 3){
+            assert(tree.insert(key, i) == ref.emplace(key, i).second);
+        } else assert(tree.erase(key) == bool(ref.erase(key)));
+
+        if (i % 5000 == 0)
+            check(tree, ref);
+    }
+    check(tree, ref);
+
+    assert(tree.min() == ref.begin()->first && tree.max() == ref.rbegin()->first);
+    assert(*tree.find(ref.begin()->first) == ref.begin()->second && !tree.find(-1));
+
+    //range scan over leaf chain
+    auto it = tree.lower_bound(1000);
+    auto rit = ref.lower_bound(1000);
+    for (;rit != ref.end() && rit->first < 2000; ++it, ++rit)
+        assert(it.key() == rit->first && it.value() == rit->second);
+
+    for ([[maybe_unused]] auto& [key, val] : ref)
+        assert(tree.erase(key));
+    assert(tree.empty() && tree.height() == 1 && tree.begin() == tree.end());
+
+    [[maybe_unused]] bool thrown = false;
+    try {
+        tree.min();
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    //sequential load keeps height logarithmic
+    BPlusTree<uint64_t, uint64_t> seq;
+    for (uint64_t i = 0; i < 100000; i++)
+        seq.insert(i, i * 2);
+    assert(seq.height() <= 6 && *seq.find(77777) == 155554);
+
+    //bulk load
+    std::vector<std::pair<int, std::string>> items;
+    for (int i = 0; i < 10007; i++)
+        items.emplace_back(i * 3, std::to_string(i));
+
+    auto bulk = BPlusTree<int, std::string, std::less<int>, 256>::from_sorted(items);
+    assert(bulk.size() == items.size() && bulk.min() == 0 && bulk.max() == 30018);
+    assert(*bulk.find(300) == "100" && !bulk.contains(301));
+    assert(bulk.lower_bound(301).key() == 303);
+
+    size_t cnt = 0;
+    for (auto i = bulk.begin(); i != bulk.end(); ++i, cnt++)
+        assert(i.key() == items[cnt].first);
+    assert(cnt == items.size());
+
+    for (int i = 0; i < 10007; i += 2)
+        assert(bulk.erase(i * 3));
+    assert(bulk.insert(1, "x") && !bulk.insert(3, "y") && *bulk.find(3) == "1");
+
+    items[5].first = 0;
+    thrown = false;
+    try {
+        bulk.assign_sorted(items);
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    assert(thrown && bulk.size() == 5003 + 1);
+
+    //string keys go through generic binary search
+    BPlusTree<std::string, int> words;
+    for (int i = 0; i < 1000; i++)
+        words.insert(std::to_string(i), i);
+    assert(words.min() == "0" && words.max() == "999" && *words.find("500") == 500);
+
+    //const lookups work with non-const comparator
+    BPlusTree<int, int, Comp<int> > plain;
+    for (int i = 0; i < 1000; i++)
+        plain.insert(i * 7 % 1000, i);
+    assert(plain.size() == 1000 && plain.contains(700) && !plain.contains(1000));
+    assert(plain.erase(700) && !plain.contains(700) && *plain.find(7) == 1);
+
+    cout << "BPlusTree test passed" << endl;
+
+    return 0;
+}
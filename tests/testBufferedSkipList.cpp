@@ -0,0 +1,85 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cassert>
+#include <structarnica/buffered_skip_list.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    BufferedSkipList<int> ingest(16);
+    std::vector<int> model;
+    std::mt19937 rng(5);
+
+    for (int i = 0; i < 10000; i++){
+        int v = rng() % 100000;
+        ingest.insert(v);
+        model.push_back(v);
+
+        //freshly inserted value is visible before any flush
+        assert(ingest.contains(v));
+        assert(ingest.buffered() < 16);
+    }
+
+    assert(ingest.size() == model.size());
+
+    //removes hit buffer or list
+    for (int i = 0; i < 1000; i++){
+        int v = model[rng() % model.size()];
+        ingest.remove(v);
+        model.erase(std::find(model.begin(), model.end(), v));
+    }
+    assert(ingest.size() == model.size());
+
+    std::sort(model.begin(), model.end());
+    assert(std::equal(ingest.begin(), ingest.end(), model.begin(), model.end()));
+    assert(!ingest.buffered());
+
+    ingest.insert(-5);
+    assert(ingest.buffered() == 1 && ingest.contains(-5));
+    assert(*ingest.lower_bound(-100) == -5 && !ingest.buffered());
+    assert(ingest.list().rank(model[0]) == 1);
+
+    //unsorted batch is rejected by the list
+    SkipList<int> lst;
+    lst.insert_sorted(std::vector<int>{1, 3, 5});
+    lst.insert_sorted(std::vector<int>{0, 2, 2, 6});
+    assert(lst.size() == 7 && std::is_sorted(lst.begin(), lst.end()));
+
+    [[maybe_unused]] bool thrown = false;
+    try {
+        lst.insert_sorted(std::vector<int>{4, 1});
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    assert(thrown && lst.size() == 8);
+
+    //dense batch: each search climbs only few levels from the previous
+    //element, compares do not grow with log of list size
+    size_t compares = 0;
+    auto counting = [&compares](int a, int b){ compares++; return a < b; };
+    SkipList<int, decltype(counting)> big(SkipList<int>::MaxLevels, 0.5, HeapNodes(), counting);
+    for (int i = 0; i < 20000; i += 2)
+        big.insert(i);
+
+    std::vector<int> odd;
+    for (int i = 1; i < 20000; i += 2)
+        odd.push_back(i);
+
+    compares = 0;
+    big.insert_sorted(odd);
+    assert(compares < 8 * odd.size());
+    assert(big.size() == 20000);
+    for (int i = 0; i < 20000; i += 331)
+        assert(big.rank(i) == size_t(i) && *big.select(i) == i);
+
+    ingest.clear();
+    assert(ingest.empty() && ingest.begin() == ingest.end());
+
+    cout << "Buffered skip list test passed" << endl;
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <cassert>
+#include <structarnica/concurrent_skip_list.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    ConcurrentSkipList<int> lst;
+
+    assert(lst.insert(5));
+    assert(!lst.insert(5));
+    assert(lst.contains(5));
+    assert(lst.erase(5));
+    assert(!lst.erase(5));
+    assert(lst.empty());
+
+    const int n_threads = 8;
+    const int per_thread = 20000;
+
+    //every thread owns keys equal to its id modulo n_threads
+    //odd keys are erased again, so only even ones must survive
+    std::vector<std::thread> workers;
+    for (int t = 0; t < n_threads; t++){
+        workers.emplace_back([&lst, t]{
+            for (int i = 0; i < per_thread; i++)
+                lst.insert(i * n_threads + t);
+
+            for (int i = 0; i < per_thread; i++){
+                int key = i * n_threads + t;
+                if (key % 2)
+                    assert(lst.erase(key));
+                assert(lst.contains(key) == !(key % 2));
+            }
+        });
+    }
+
+    //readers racing with writers
+    for (int t = 0; t < 2; t++){
+        workers.emplace_back([&lst]{
+            for (int i = 0; i < per_thread * n_threads; i += 7)
+                lst.contains(i);
+        });
+    }
+
+    for (auto& w : workers)
+        w.join();
+
+    assert(lst.size() == size_t(n_threads * per_thread / 2));
+
+    int prev = -1;
+    size_t cnt = 0;
+    lst.for_each([&](int x){
+        assert(x > prev && x % 2 == 0);
+        prev = x;
+        cnt++;
+    });
+    assert(cnt == lst.size());
+
+    //size is summed over stripes of all threads, erase by other thread
+    //than insert leaves negative stripe
+    for (int key = 0; key < 1000; key += 2)
+        assert(lst.erase(key));
+    assert(lst.size() == size_t(n_threads * per_thread / 2 - 500));
+
+    cout << "concurrent skip list: " << lst.size() << " keys\n";
+
+    return 0;
+}
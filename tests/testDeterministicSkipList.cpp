@@ -0,0 +1,86 @@
+#include <iostream>
+#include <set>
+#include <random>
+#include <cassert>
+#include <structarnica/deterministic_skip_list.hpp>
+
+using namespace std;
+using namespace DS;
+
+//height bound of 1-2-3 skip list
+bool bounded(size_t height, size_t n) {
+    size_t log = 0;
+    for (;(size_t(1) << log) <= n; log++);
+    return height <= log + 2;
+}
+
+int main() {
+
+    DeterministicSkipList<int> list;
+
+    assert(list.empty() && !list.remove(1) && list.begin() == list.end());
+
+    //sorted input is the worst case for naive balancing
+    for (int i = 0; i < 10000; i++)
+        assert(list.insert(i).second);
+
+    assert(!list.insert(5000).second);
+    assert(list.size() == 10000);
+    assert(bounded(list.height(), list.size()));
+
+    [[maybe_unused]] int expect = 0;
+    for ([[maybe_unused]] int v : list)
+        assert(v == expect++);
+    assert(expect == 10000);
+
+    assert(*list.lower_bound(-5) == 0);
+    assert(list.lower_bound(10000) == list.end());
+    assert(list.contains(9999) && !list.contains(10000));
+
+    //drop every other one, then everything from the front
+    for (int i = 0; i < 10000; i += 2)
+        assert(list.remove(i));
+    assert(!list.remove(0));
+    assert(list.size() == 5000 && bounded(list.height(), 5000));
+    assert(*list.find(1) == 1 && list.find(2) == list.end());
+
+    for (int i = 1; i < 10000; i += 2)
+        assert(list.remove(i));
+    assert(list.empty() && list.height() <= 2);
+
+    //random workload against std::set
+    DeterministicSkipList<int> det;
+    std::set<int> model;
+    std::mt19937 rng(7);
+
+    for (int i = 0; i < 200000; i++){
+        [[maybe_unused]] int v = rng() % 5000;
+
+        if (rng() % 3)
+            assert(det.insert(v).second == model.insert(v).second);
+        else assert(det.remove(v) == (model.erase(v) > 0));
+
+        if (i % 10000 == 0){
+            assert(det.size() == model.size());
+            assert(bounded(det.height(), det.size()));
+            [[maybe_unused]] auto it = model.begin();
+            for ([[maybe_unused]] int x : det)
+                assert(x == *it++);
+            assert(it == model.end());
+        }
+    }
+
+    for ([[maybe_unused]] int v : model)
+        assert(det.remove(v));
+    assert(det.empty());
+
+    det.insert(3);
+    det.clear();
+    assert(det.empty() && det.begin() == det.end());
+    det.insert(4);
+    assert(*det.begin() == 4);
+
+    cout << "Deterministic skip list test passed" << endl;
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <structarnica/expiry_index.hpp>
+
+using namespace std;
+using namespace DS;
+
+//payload that counts its copies
+struct Tracked {
+    static inline int copies = 0;
+
+    int id;
+
+    Tracked(int id):id{id} {}
+    Tracked(const Tracked& o):id{o.id} { copies++; }
+    Tracked(Tracked&&) = default;
+    Tracked& operator=(const Tracked& o) { id = o.id; copies++; return *this; }
+    Tracked& operator=(Tracked&&) = default;
+};
+
+int main() {
+
+    ExpiryIndex<std::string> sessions;
+    std::vector<ExpiryIndex<std::string>::Handle> handles;
+
+    //deadlines 1..100, ten sessions each
+    for (int i = 0; i < 1000; i++)
+        handles.push_back(sessions.insert(i % 100 + 1, "session" + std::to_string(i)));
+
+    assert(sessions.size() == 1000 && *sessions.next_deadline() == 1);
+    assert(sessions.pop_until(0).empty() && sessions.size() == 1000);
+
+    //session 5 is kept alive, session 6 is closed
+    [[maybe_unused]] auto moved = sessions.reschedule(handles[5], 500);
+    assert(moved && moved->deadline == 500);
+    assert(!sessions.contains(handles[5]) && sessions.contains(*moved));
+    assert(!sessions.reschedule(handles[5], 600));
+
+    assert(sessions.cancel(handles[6]) && !sessions.cancel(handles[6]));
+
+    auto expired = sessions.pop_until(10);
+    assert(expired.size() == 98 && sessions.size() == 901);
+    assert(*sessions.next_deadline() == 11);
+
+    [[maybe_unused]] uint64_t last = 0;
+    for (auto& e : expired){
+        assert(e.deadline <= 10 && e.deadline >= last);
+        assert(e.payload != "session5" && e.payload != "session6");
+        last = e.deadline;
+    }
+
+    //equal deadlines come out in insertion order
+    assert(expired.begin()->payload == "session0");
+    assert(std::next(expired.begin())->payload == "session100");
+
+    assert(sessions.pop_until(10).empty());
+
+    auto rest = sessions.pop_until(1000);
+    assert(rest.size() == 901 && sessions.empty() && !sessions.next_deadline());
+    assert(rest[rest.size() - 1].payload == "session5");
+
+    //index keeps working after being drained
+    [[maybe_unused]] auto h = sessions.insert(2000, "late");
+    assert(sessions.contains(h) && sessions.pop_until(2000).size() == 1);
+
+    //reschedule moves payload, never copies it
+    ExpiryIndex<Tracked> timers;
+    std::vector<ExpiryIndex<Tracked>::Handle> ids;
+
+    for (int i = 0; i < 100; i++)
+        ids.push_back(timers.insert(i, Tracked(i)));
+
+    for (int i = 0; i < 100; i++)
+        ids[i] = *timers.reschedule(ids[i], 1000 - i);
+
+    assert(Tracked::copies == 0);
+
+    auto fired = timers.pop_until(1000);
+    assert(fired.size() == 100 && fired.begin()->payload.id == 99);
+
+    cout << "Expiry index test passed" << endl;
+
+    return 0;
+}
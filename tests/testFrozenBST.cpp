@@ -0,0 +1,88 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cassert>
+#include <structarnica/bst.hpp>
+#include <structarnica/frozen_bst.hpp>
+
+using namespace std;
+using namespace DS;
+
+//BST accepts comparator with non-const call operator, so must freeze()
+struct Greater {
+    bool operator()(int a, int b){ return a > b; }
+};
+
+int main() {
+
+    std::mt19937 gen(3);
+    BST<int, std::less<int>, AVL> tree;
+    std::vector<int> ref;
+
+    for (int i = 0; i < 10000; i++){
+        int x = gen() % 20000;
+        tree.insert(x);
+        ref.push_back(x);
+    }
+    std::sort(ref.begin(), ref.end());
+
+    auto frozen = tree.freeze();
+    assert(frozen.size() == ref.size());
+    std::vector<int> keys(ref);
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    assert(frozen.distinct() == keys.size());
+
+    for (int x = -1; x <= 20001; x++){
+        [[maybe_unused]] auto lb = std::lower_bound(ref.begin(), ref.end(), x);
+        [[maybe_unused]] auto ub = std::upper_bound(ref.begin(), ref.end(), x);
+
+        assert(frozen.contains(x) == (lb != ub));
+        assert(frozen.count(x) == unsigned(ub - lb));
+        assert(frozen.rank(x) == size_t(lb - ref.begin()));
+
+        [[maybe_unused]] const int* res = frozen.lower_bound(x);
+        assert(lb == ref.end() ? !res : *res == *lb);
+    }
+
+    //every size of the implicit tree, complete or not
+    for (int n = 0; n < 70; n++){
+        std::vector<int> even;
+        for (int i = 0; i < n; i++)
+            even.push_back(2 * i);
+
+        FrozenBST<int> small(even);
+        assert(small.size() == size_t(n) && small.empty() == !n);
+
+        for (int x = -1; x <= 2 * n; x++){
+            assert(small.contains(x) == (x >= 0 && x % 2 == 0 && x < 2 * n));
+            assert(small.rank(x) == size_t(std::min((x + 1) / 2, n)));
+        }
+    }
+
+    //frozen copy does not follow the tree
+    BST<int> plain;
+    plain.insert(5);
+    auto snap = plain.freeze();
+    plain.insert(7);
+    assert(snap.contains(5) && !snap.contains(7));
+
+    BST<int, Greater> desc;
+    for (int x : {4, 9, 1, 9, 6})
+        desc.insert(x);
+    const auto frozen_desc = desc.freeze();
+    assert(frozen_desc.contains(9) && frozen_desc.count(9) == 2 && !frozen_desc.contains(5));
+    assert(frozen_desc.rank(6) == 2 && *frozen_desc.lower_bound(5) == 4);
+
+    [[maybe_unused]] bool thrown = false;
+    try {
+        FrozenBST<int> bad(std::vector<int>{1, 1, 2});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    cout << "FrozenBST test passed" << endl;
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include <structarnica/mvcc_skip_list.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    MVCCSkipList<int> set;
+
+    for (int i = 0; i < 100; i++)
+        assert(set.insert(i));
+
+    assert(!set.insert(10));
+    assert(set.size() == 100);
+    //no snapshots, nothing but live versions is kept
+    assert(set.versions() == 100);
+
+    {
+        auto snap = set.snapshot();
+
+        //writes after the snapshot are invisible to it
+        for (int i = 0; i < 100; i += 2)
+            assert(set.remove(i));
+        assert(set.insert(1000));
+        assert(set.insert(0));
+
+        assert(set.size() == 52);
+        assert(!set.contains(2) && set.contains(0) && set.contains(1000));
+
+        assert(snap.contains(2) && !snap.contains(1000));
+
+        [[maybe_unused]] int expect = 0;
+        for ([[maybe_unused]] int v : snap)
+            assert(v == expect++);
+        assert(expect == 100);
+
+        //latest view
+        vector<int> latest(set.begin(), set.end());
+        assert(latest.size() == 52);
+        assert(latest.front() == 0 && latest[1] == 1 && latest[2] == 3 && latest.back() == 1000);
+
+        //older versions stay while snapshot lives
+        assert(set.versions() > 101);
+
+        auto inner = set.snapshot();
+        assert(inner.sequence() > snap.sequence());
+        assert(!inner.contains(2) && inner.contains(1000));
+    }
+
+    //both snapshots are gone, only live versions are left
+    assert(set.versions() == set.size());
+
+    for (int i = 0; i < 100; i++)
+        set.remove(i);
+    assert(set.size() == 1 && set.versions() == 1);
+
+    //snapshot stays consistent while another thread writes
+    MVCCSkipList<int> shared;
+    for (int i = 0; i < 1000; i++)
+        shared.insert(i * 2);
+
+    {
+        auto snap = shared.snapshot();
+
+        thread writer([&]{
+            for (int round = 0; round < 20; round++){
+                for (int i = 0; i < 1000; i++){
+                    shared.remove(i * 2);
+                    shared.insert(i * 2 + 1);
+                }
+                for (int i = 0; i < 1000; i++){
+                    shared.remove(i * 2 + 1);
+                    shared.insert(i * 2);
+                }
+            }
+        });
+
+        for (int pass = 0; pass < 20; pass++){
+            int expect = 0;
+            for ([[maybe_unused]] int v : snap){
+                assert(v == expect);
+                expect += 2;
+            }
+            assert(expect == 2000);
+        }
+
+        writer.join();
+    }
+
+    assert(shared.size() == 1000 && shared.versions() == 1000);
+
+    cout << "MVCC skip list test passed" << endl;
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <atomic>
+#include <string>
+#include <cassert>
+#include <structarnica/skip_list.hpp>
+#include <structarnica/parallel.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    SkipList<long> lst;
+    for (long i = 0; i < 200000; i++)
+        lst.insert(i);
+
+    //cuts are balanced and ordered
+    auto cuts = lst.partition(7);
+    assert(cuts.size() == 8 && cuts.front() == lst.begin() && cuts.back() == lst.end());
+    for (size_t i = 1; i < 7; i++)
+        assert(*cuts[i] == long(i * 200000 / 7));
+
+    for (size_t threads : {1, 2, 4, 8}){
+        std::atomic<long> cnt{0};
+        parallel_for_each(lst, [&cnt](long v){ cnt += v % 3 == 0; }, threads);
+        assert(cnt == 66667);
+
+        [[maybe_unused]] long sum = parallel_reduce(lst, 0L, [](long acc, long v){ return acc + v; }, std::plus<long>(), threads);
+        assert(sum == 200000L * 199999 / 2);
+    }
+
+    //partial results are joined in list order
+    SkipList<std::string> words;
+    for (char c = 'a'; c <= 'z'; c++)
+        words.insert(std::string(1, c));
+
+    auto joined = parallel_reduce(words, std::string(), std::plus<std::string>(), std::plus<std::string>(), 5);
+    assert(joined == "abcdefghijklmnopqrstuvwxyz");
+
+    //more threads than elements and empty list
+    SkipList<long> few;
+    few.insert(1);
+    few.insert(2);
+    assert(parallel_reduce(few, 0L, std::plus<long>(), std::plus<long>(), 16) == 3);
+    few.clear();
+    assert(parallel_reduce(few, 0L, std::plus<long>(), std::plus<long>(), 4) == 0);
+
+    [[maybe_unused]] bool thrown = false;
+    try {
+        parallel_for_each(lst, [](long v){ if (v == 150000) throw std::runtime_error("bad"); }, 4);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    cout << "Parallel scan test passed" << endl;
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <structarnica/pool_bst.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    static_assert(PoolBST<uint32_t>::NodeSize == 16, "32 bit links");
+
+    PoolBST<uint32_t> tree;
+    std::map<uint32_t, unsigned> ref;
+    std::mt19937 gen(5);
+    size_t total = 0;
+
+    for (int i = 0; i < 50000; i++){
+        uint32_t x = gen() % 3000;
+
+        if (gen() % 3){
+            tree.insert(x);
+            ref[x]++;
+            total++;
+        } else {
+            tree.erase(x);
+            auto it = ref.find(x);
+            if (it != ref.end()){
+                total--;
+                if (!--it->second)
+                    ref.erase(it);
+            }
+        }
+    }
+
+    assert(tree.size() == total);
+    for ([[maybe_unused]] auto& [key, cnt] : ref)
+        assert(tree.contains(key) && tree.count(key) == cnt);
+    assert(!tree.contains(5000) && tree.count(5000) == 0);
+    assert(tree.min() == ref.begin()->first && tree.max() == ref.rbegin()->first);
+
+    std::vector<uint32_t> keys;
+    tree.inorder([&keys](uint32_t a){ keys.push_back(a); });
+    assert(keys.size() == ref.size());
+    [[maybe_unused]] auto rit = ref.begin();
+    for ([[maybe_unused]] auto k : keys)
+        assert(k == (rit++)->first);
+
+    //erased slots are reused, slab does not grow
+    assert(tree.slots() <= 3000);
+    size_t slots = tree.slots();
+    for (auto& [key, cnt] : ref){
+        for (unsigned i = 0; i < cnt; i++)
+            tree.erase(key);
+    }
+    assert(tree.empty());
+    for (uint32_t i = 0; i < slots; i++)
+        tree.insert(i);
+    assert(tree.slots() == slots && tree.size() == slots);
+
+    tree.clear();
+    assert(tree.empty() && tree.slots() == 0 && !tree.contains(1));
+
+    [[maybe_unused]] bool thrown = false;
+    try {
+        tree.min();
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    tree.insert(7);
+    assert(tree.min() == 7 && tree.max() == 7);
+
+    cout << "PoolBST test passed" << endl;
+
+    return 0;
+}
@@ -7,6 +7,9 @@
 #include <vector>
 #include <random>
 #include <functional>
+#include <cassert>
+#include <cmath>
+#include <string>
 #include <structarnica/skip_list.hpp>
 
 using namespace std;
@@ -45,5 +48,433 @@ int main() {
 
     cout << lst.dump();
 
+    assert(!lst.find(1000));
+    assert(lst.size() == 11);
+    assert(std::is_sorted(lst.begin(), lst.end()));
+
+    //towers: every node on level 0, duplicates are kept
+    SkipList<int> towers(8);
+    for (int i = 0; i < 1000; i++)
+        towers.insert((i * 7919) % 1000);
+    towers.insert(500);
+
+    assert(towers.size() == 1001);
+    assert(std::is_sorted(towers.begin(), towers.end()));
+    assert(*towers.find(500) == 500);
+
+    for (int i = 0; i < 1000; i += 2)
+        towers.remove(i);
+
+    assert(*towers.find(500) == 500);
+    towers.remove(500);
+    assert(!towers.find(500));
+    assert(towers.size() == 500);
+    assert(std::is_sorted(towers.begin(), towers.end()));
+    for ([[maybe_unused]] auto x : towers)
+        assert(x % 2);
+
+    //bulk load from sorted snapshot
+    std::vector<int> sorted(10000);
+    for (int i = 0; i < 10000; i++)
+        sorted[i] = i * 2;
+
+    auto loaded = SkipList<int>::from_sorted(sorted, 12, true);
+    assert(loaded.size() == sorted.size());
+    assert(std::equal(loaded.begin(), loaded.end(), sorted.begin()));
+    assert(*loaded.find(5000) == 5000);
+    assert(!loaded.find(5001));
+    loaded.insert(5001);
+    assert(*loaded.find(5001) == 5001);
+
+    loaded.assign_sorted(std::views::iota(0, 100));
+    assert(loaded.size() == 100);
+    assert(*loaded.find(99) == 99);
+
+    [[maybe_unused]] bool thrown = false;
+    try {
+        loaded.assign_sorted(std::vector<int>{3, 2, 1});
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    assert(thrown && loaded.empty());
+
+    //ordered lookups and range erase with duplicates
+    SkipList<int> bounds(8);
+    for (int i = 0; i < 50; i++){
+        bounds.insert(i);
+        bounds.insert(i);
+    }
+
+    assert(*bounds.lower_bound(10) == 10);
+    assert(*bounds.upper_bound(10) == 11);
+    assert(bounds.upper_bound(49) == bounds.end());
+    assert(std::distance(bounds.equal_range(7).first, bounds.equal_range(7).second) == 2);
+
+    //long run of equal keys: equal_range descends twice, never walks the run
+    {
+        size_t compares = 0;
+        auto counting = [&compares](int a, int b){ compares++; return a < b; };
+        SkipList<int, decltype(counting)> runs(SkipList<int>::MaxLevels, 0.5, HeapNodes(), counting);
+        for (int i = 0; i < 10000; i++)
+            runs.insert(i < 1000 || i >= 9000 ? i : 5000);
+
+        compares = 0;
+        [[maybe_unused]] auto [run_first, run_last] = runs.equal_range(5000);
+        assert(compares < 200);
+        assert(*run_first == 5000 && *run_last == 9000 && std::distance(run_first, run_last) == 8000);
+    }
+
+    auto second_ten = std::next(bounds.lower_bound(10));
+    bounds.erase(second_ten, bounds.lower_bound(20));
+    assert(bounds.size() == 81);
+    assert(*bounds.find(10) == 10 && !bounds.find(11) && *bounds.find(20) == 20);
+    assert(*std::next(bounds.find(10)) == 20);
+    assert(*std::prev(bounds.find(20)) == 10);
+    assert(std::is_sorted(bounds.begin(), bounds.end()));
+
+    assert(bounds.insert_unique(10).second == false);
+    assert(bounds.insert_unique(15).second == true);
+
+    //top level follows size, any promotion probability works
+    for (double p : {0.5, 0.25, 0.3}){
+        SkipList<int> adaptive(SkipList<int>::MaxLevels, p);
+        adaptive.seed(42);
+        assert(adaptive.levels() == 1);
+
+        for (int i = 0; i < 100000; i++)
+            adaptive.insert((i * 7919) % 100000);
+
+        [[maybe_unused]] size_t expected = std::log(100000) / std::log(1 / p);
+        assert(adaptive.levels() >= expected - 2 && adaptive.levels() <= expected + 3);
+        assert(adaptive.size() == 100000);
+        assert(std::is_sorted(adaptive.begin(), adaptive.end()));
+        assert(*adaptive.find(4242) == 4242);
+        cout << "p = " << p << " levels: " << adaptive.levels() << '\n';
+    }
+
+    //positional access follows every kind of modification
+    SkipList<int> ranked;
+    std::vector<int> model;
+    auto check_ranks = [&]{
+        assert(ranked.size() == model.size());
+        for (size_t i = 0; i < model.size(); i++){
+            assert(ranked[i] == model[i]);
+            assert(ranked.rank(model[i]) == size_t(std::lower_bound(model.begin(), model.end(), model[i]) - model.begin()));
+        }
+        assert(ranked.select(model.size()) == ranked.end());
+    };
+
+    for (int i = 0; i < 2000; i++){
+        int v = rnd();
+        ranked.insert(v);
+        model.insert(std::upper_bound(model.begin(), model.end(), v), v);
+    }
+    check_ranks();
+
+    for (int i = 0; i < 500; i++){
+        int v = rnd();
+        if (ranked.find(v)){
+            ranked.remove(v);
+            model.erase(std::lower_bound(model.begin(), model.end(), v));
+        }
+    }
+    check_ranks();
+
+    for (size_t k = 0; k < 300; k++){
+        size_t pos = (k * 7) % model.size();
+        ranked.erase_at(pos);
+        model.erase(model.begin() + pos);
+    }
+    check_ranks();
+
+    ranked.erase(ranked.select(100), ranked.select(400));
+    model.erase(model.begin() + 100, model.begin() + 400);
+    check_ranks();
+
+    ranked.assign_sorted(model);
+    check_ranks();
+    ranked.insert(500);
+    model.insert(std::upper_bound(model.begin(), model.end(), 500), 500);
+    check_ranks();
+
+    //ascending keys go through the finger
+    SkipList<int> series;
+    for (int i = 0; i < 100000; i += 2)
+        series.insert(i);
+    for (int i = 1; i < 100000; i += 2)
+        series.insert(i);
+    series.insert(-1);
+    series.insert(5);
+
+    assert(series.size() == 100002);
+    assert(std::is_sorted(series.begin(), series.end()));
+    for (int i = 0; i < 100000; i += 997)
+        assert(series.rank(i) == size_t(i + 1 + (i > 5)));
+    assert(series[0] == -1 && series[100001] == 99999);
+
+    series.remove(5);
+    series.insert(100000);
+    assert(series[series.size() - 1] == 100000);
+    assert(series.insert_unique(100000).second == false);
+    assert(std::is_sorted(series.begin(), series.end()));
+
+    //timestamps out of order by few positions climb back along the finger,
+    //compares do not grow with log of list size
+    {
+        size_t compares = 0;
+        auto counting = [&compares](int a, int b){ compares++; return a < b; };
+        SkipList<int, decltype(counting)> events(SkipList<int>::MaxLevels, 0.5, HeapNodes(), counting);
+        std::vector<int> stamps;
+        std::mt19937 jitter(11);
+        size_t late = 0;
+        size_t late_compares = 0;
+
+        for (int i = 0; i < 100000; i++){
+            int v = 4 * i + int(jitter() % 24);
+            size_t was = compares;
+            events.insert(v);
+            if (!stamps.empty() && v < stamps.back()){
+                late++;
+                late_compares += compares - was;
+            }
+            stamps.push_back(v);
+        }
+
+        assert(late > stamps.size() / 4 && late_compares < 12 * late);
+        std::sort(stamps.begin(), stamps.end());
+        assert(events.size() == stamps.size() && std::equal(events.begin(), events.end(), stamps.begin()));
+        for (size_t i = 0; i < stamps.size(); i += 991)
+            assert(events[i] == stamps[i] && events.rank(stamps[i]) == size_t(std::lower_bound(stamps.begin(), stamps.end(), stamps[i]) - stamps.begin()));
+    }
+
+    //batched lookups agree with single ones
+    std::vector<int> probes;
+    for (int i = -10; i < 100020; i += 3)
+        probes.push_back(i);
+
+    std::vector<SkipList<int>::iterator> found;
+    series.find_many(probes, std::back_inserter(found));
+    std::vector<bool> present;
+    series.contains_many(probes, std::back_inserter(present));
+
+    assert(found.size() == probes.size() && present.size() == probes.size());
+    for (size_t i = 0; i < probes.size(); i++){
+        assert(found[i] == series.find(probes[i]));
+        assert(present[i] == series.contains(probes[i]));
+    }
+
+    //shard rebalancing: split by key and glue back
+    {
+        SkipList<int> shard;
+        std::vector<int> keys;
+        for (int i = 0; i < 5000; i++){
+            int v = rnd();
+            shard.insert(v);
+            keys.insert(std::upper_bound(keys.begin(), keys.end(), v), v);
+        }
+
+        auto upper = shard.split_at(500);
+        [[maybe_unused]] size_t low_cnt = std::lower_bound(keys.begin(), keys.end(), 500) - keys.begin();
+        assert(shard.size() == low_cnt && upper.size() == keys.size() - low_cnt);
+        assert(std::equal(shard.begin(), shard.end(), keys.begin()));
+        assert(std::equal(upper.begin(), upper.end(), keys.begin() + low_cnt));
+        for (size_t i = 0; i < upper.size(); i += 17)
+            assert(upper[i] == keys[low_cnt + i] && upper.rank(upper[i]) <= i);
+        assert(upper[upper.size() - 1] == keys.back());
+
+        upper.insert(990);
+        shard.insert(10);
+        keys.insert(std::upper_bound(keys.begin(), keys.end(), 990), 990);
+        keys.insert(std::upper_bound(keys.begin(), keys.end(), 10), 10);
+
+        auto empty_tail = upper.split_at(100000);
+        assert(empty_tail.empty());
+        shard.concat(empty_tail);
+
+        shard.concat(upper);
+        assert(upper.empty() && upper.begin() == upper.end());
+        assert(shard.size() == keys.size());
+        assert(std::equal(shard.begin(), shard.end(), keys.begin()));
+        for (size_t i = 0; i < keys.size(); i += 13)
+            assert(shard[i] == keys[i]);
+        assert(*std::prev(shard.find(keys[low_cnt + 1])) == keys[low_cnt]);
+
+        SkipList<int> low;
+        low.insert(1000);
+        [[maybe_unused]] bool overlap = false;
+        try {
+            low.concat(shard);
+        } catch (const std::logic_error&) {
+            overlap = true;
+        }
+        assert(overlap && low.size() == 1);
+
+        SkipList<int> none;
+        none.concat(shard);
+        assert(shard.empty() && none.size() == keys.size());
+        assert(std::equal(none.begin(), none.end(), keys.begin()));
+    }
+
+    //arena mode: write buffer that is filled and dropped as a whole
+    SkipList<int, std::less<>, ArenaNodes> memtable(SkipList<int>::MaxLevels, 0.25, ArenaNodes(1 << 12));
+    [[maybe_unused]] size_t chunks = 0;
+    for (int round = 0; round < 3; round++){
+        for (int i = 0; i < 20000; i++)
+            memtable.insert(rnd());
+        for (int i = 0; i < 1000; i++)
+            memtable.remove(rnd());
+        for (int i = 0; i < 1000; i++)
+            memtable.insert(rnd());
+
+        assert(std::is_sorted(memtable.begin(), memtable.end()));
+
+        //same amount of data fits into chunks kept from first round
+        if (round == 0)
+            chunks = memtable.allocator().arena().chunks();
+        assert(memtable.allocator().arena().chunks() <= chunks + 1);
+
+        memtable.clear();
+        assert(memtable.empty() && memtable.begin() == memtable.end());
+    }
+
+    //alignment padding past the end of chunk takes new chunk
+    {
+        Arena arena(100);
+        [[maybe_unused]] char* odd = static_cast<char*>(arena.allocate(99, 1));
+        void* wide = arena.allocate(8, 64);
+        assert(reinterpret_cast<uintptr_t>(wide) % 64 == 0 && arena.chunks() == 2);
+        assert(wide < odd || wide >= odd + 99);
+        std::fill_n(static_cast<char*>(wide), 8, 'x');
+    }
+
+    SkipList<std::string, std::less<>, ArenaNodes> names;
+    names.insert("bob");
+    names.insert("alice");
+    names.remove("bob");
+    names.insert(std::string(100, 'x'));
+    assert(*names.begin() == "alice" && names.size() == 2);
+
+    //lazy delete: burst of removes only marks nodes
+    {
+        SkipList<int> lazy;
+        lazy.set_lazy(true, 1.0);
+
+        for (int i = 0; i < 1000; i++)
+            lazy.insert(i);
+
+        [[maybe_unused]] auto kept = lazy.find(501);
+        for (int i = 0; i < 1000; i += 2)
+            lazy.remove(i);
+        lazy.remove(0);
+
+        assert(lazy.size() == 500 && lazy.tombstones() == 500);
+        assert(!lazy.contains(500) && lazy.contains(501) && *kept == 501);
+        assert(*lazy.begin() == 1 && *lazy.lower_bound(500) == 501);
+        assert(*lazy.upper_bound(501) == 503 && *std::prev(lazy.find(503)) == 501);
+
+        //every way of walking skips tombstones
+        auto back = lazy.find(503);
+        [[maybe_unused]] auto was = back--;
+        assert(*was == 503 && *back == 501);
+        assert(*lazy.cbegin() == 1 && lazy.cend() == lazy.end());
+        [[maybe_unused]] auto citer = lazy.cbegin();
+        assert(*++citer == 3 && *citer++ == 3 && *citer == 5 && *citer-- == 5 && *citer == 3);
+        assert(std::equal(lazy.cbegin(), lazy.cend(), lazy.begin()));
+
+        [[maybe_unused]] auto [eq_first, eq_last] = lazy.equal_range(10);
+        assert(eq_first == eq_last && *eq_first == 11);
+
+        int expect = 1;
+        for ([[maybe_unused]] int v : lazy){
+            assert(v == expect);
+            expect += 2;
+        }
+        assert(expect == 1001);
+
+        //tombstone is brought back by unique insert
+        assert(lazy.insert_unique(10).second && lazy.contains(10));
+        assert(!lazy.insert_unique(10).second);
+        assert(lazy.tombstones() == 499);
+
+        //positional operations see only live elements
+        assert(lazy.rank(11) == 6 && lazy[5] == 10);
+        assert(!lazy.tombstones() && lazy.size() == 501);
+
+        for (int i = 1; i < 1000; i += 2)
+            lazy.remove(i);
+        lazy.compact();
+        assert(lazy.size() == 1 && *lazy.begin() == 10 && lazy.select(0) == lazy.begin());
+
+        //automatic compaction keeps tombstones under the ratio
+        lazy.set_lazy(true, 0.25);
+        for (int i = 0; i < 2000; i++)
+            lazy.insert(i);
+        for (int i = 0; i < 2000; i++){
+            lazy.remove(i);
+            assert(lazy.tombstones() <= (lazy.size() + lazy.tombstones()) / 4 + 1);
+        }
+        assert(lazy.size() == 1);
+
+        lazy.remove(10);
+        lazy.set_lazy(false);
+        assert(lazy.empty() && !lazy.tombstones() && lazy.begin() == lazy.end());
+    }
+
+    //custom order
+    SkipList<int, std::greater<>> desc(8);
+    for (int i = 0; i < 100; i++)
+        desc.insert((i * 37) % 100);
+    assert(std::is_sorted(desc.begin(), desc.end(), std::greater<>()));
+    assert(*desc.begin() == 99 && *desc.lower_bound(50) == 50 && *desc.upper_bound(50) == 49);
+    assert(desc.rank(90) == 9 && desc.insert_unique(7).second == false);
+
+    //node handles move entries without reallocating
+    {
+        SkipList<std::string> hot, cold;
+        for (int i = 0; i < 200; i++)
+            hot.insert(std::to_string(1000 + i));
+
+        auto nh = hot.extract(std::string("1050"));
+        assert(nh && nh.value() == "1050" && hot.size() == 199 && !hot.contains("1050"));
+        [[maybe_unused]] const std::string* addr = &nh.value();
+
+        [[maybe_unused]] auto pos = cold.insert(std::move(nh));
+        assert(!nh && &*pos == addr && cold.size() == 1);
+        assert(!hot.extract(std::string("nope")) && cold.insert(SkipList<std::string>::node_type()) == cold.end());
+
+        //changed value goes to its new place
+        auto moved = cold.extract(cold.begin());
+        moved.value() = "0999";
+        hot.insert(std::move(moved));
+        assert(*hot.begin() == "0999" && hot.rank("1000") == 1 && cold.empty());
+
+        //interleaved ranges go node by node, tombstones are dropped
+        for (int i = 0; i < 300; i += 3)
+            cold.insert(std::to_string(1000 + i));
+        cold.set_lazy(true, 1.0);
+        cold.remove("1003");
+        hot.merge(cold);
+        assert(cold.empty() && cold.begin() == cold.end() && hot.size() == 299);
+        assert(std::is_sorted(hot.begin(), hot.end()) && *hot.select(298) == "1297");
+
+        //range after the last element is concatenated
+        for (int i = 0; i < 50; i++)
+            cold.insert(std::to_string(2000 + i));
+        hot.merge(cold);
+        assert(cold.empty() && hot.size() == 349 && *hot.select(348) == "2049");
+
+        size_t cnt = 0;
+        for (auto it = hot.begin(); it != hot.end(); ++it, cnt++);
+        assert(cnt == hot.size() && hot.rank("2000") == 299);
+    }
+
+    [[maybe_unused]] bool bad_p = false;
+    try {
+        SkipList<int> wrong(8, 1.0);
+    } catch (const std::invalid_argument&) {
+        bad_p = true;
+    }
+    assert(bad_p);
+
     return 0;
 }
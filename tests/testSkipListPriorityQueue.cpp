@@ -0,0 +1,84 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <random>
+#include <cassert>
+#include <structarnica/skip_list_priority_queue.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    SkipListPriorityQueue<int> pq(4);
+
+    assert(pq.empty() && !pq.pop_min());
+
+    std::mt19937 rng(11);
+    std::vector<int> values;
+    for (int i = 0; i < 10000; i++){
+        values.push_back(rng() % 1000);
+        pq.push(values.back());
+    }
+    assert(pq.size() == values.size());
+
+    //single thread pops come out sorted
+    std::sort(values.begin(), values.end());
+    for (size_t i = 0; i < values.size() / 2; i++)
+        assert(*pq.pop_min() == values[i]);
+
+    //smaller keys pushed after pops go in front of what is left
+    pq.push(-1);
+    assert(*pq.pop_min() == -1);
+
+    for (size_t i = values.size() / 2; i < values.size(); i++)
+        assert(*pq.pop_min() == values[i]);
+    assert(pq.empty() && !pq.pop_min());
+
+    //producers and consumers at once, every pushed value is popped once
+    const int n_threads = 4;
+    const int per_thread = 20000;
+
+    SkipListPriorityQueue<int> shared;
+    std::atomic<int> popped{0};
+    std::vector<std::vector<int>> got(n_threads);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < n_threads; t++){
+        workers.emplace_back([&shared, t]{
+            for (int i = 0; i < per_thread; i++)
+                shared.push(i * n_threads + t);
+        });
+
+        workers.emplace_back([&shared, &popped, &got, t]{
+            for (;popped.load() < n_threads * per_thread;){
+                if (auto v = shared.pop_min()){
+                    got[t].push_back(*v);
+                    popped++;
+                }
+            }
+        });
+    }
+
+    for (auto& w : workers)
+        w.join();
+
+    //pushes and pops were counted by different threads
+    assert(shared.size() == 0);
+
+    std::vector<int> all;
+    for (auto& part : got)
+        all.insert(all.end(), part.begin(), part.end());
+    std::sort(all.begin(), all.end());
+
+    assert(all.size() == size_t(n_threads * per_thread));
+    for (int i = 0; i < n_threads * per_thread; i++)
+        assert(all[i] == i);
+    assert(shared.empty() && !shared.pop_min());
+
+    cout << "Skip list priority queue test passed" << endl;
+
+    return 0;
+}
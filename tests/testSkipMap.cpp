@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <structarnica/skip_map.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    SkipMap<int, std::string> map(8);
+
+    for (int i = 0; i < 100; i++)
+        assert(map.insert(i * 10, std::to_string(i)).second);
+
+    assert(!map.insert(10, "dup").second);
+    assert(map.find(10)->second == "1");
+    assert(map.size() == 100);
+
+    map.insert_or_assign(10, "ten");
+    assert(*map.get(10) == "ten");
+    assert(!map.get(11));
+
+    map[5] = "five";
+    assert(map.size() == 101);
+    assert(map.find(5)->second == "five");
+
+    assert(map.lower_bound(11)->first == 20);
+    assert(map.lower_bound(20)->first == 20);
+    assert(map.upper_bound(20)->first == 30);
+    assert(map.lower_bound(1000) == map.end());
+
+    [[maybe_unused]] auto [eq_first, eq_last] = map.equal_range(30);
+    assert(eq_first->first == 30 && eq_last->first == 40);
+
+    [[maybe_unused]] auto [none_first, none_last] = map.equal_range(31);
+    assert(none_first == none_last);
+
+    //all keys in [200, 300)
+    int cnt = 0;
+    for (auto it = map.lower_bound(200), last = map.lower_bound(300); it != last; ++it){
+        assert(it->first >= 200 && it->first < 300);
+        cnt++;
+    }
+    assert(cnt == 10);
+
+    //drop the same range
+    map.erase(map.lower_bound(200), map.lower_bound(300));
+    assert(map.size() == 91);
+    assert(map.lower_bound(200)->first == 300);
+    assert(!map.contains(250));
+
+    assert(map.erase(300));
+    assert(!map.erase(300));
+    assert(map.find(300) == map.end());
+
+    [[maybe_unused]] int prev = -1;
+    for (auto& e : map){
+        assert(e.first > prev);
+        prev = e.first;
+    }
+
+    map.erase(map.begin(), map.end());
+    assert(map.empty());
+
+    cout << "skip map ok\n";
+
+    return 0;
+}
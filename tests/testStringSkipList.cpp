@@ -0,0 +1,109 @@
+#define DS_DEBUG_STRING_SKIP_LIST
+#include <iostream>
+#include <string>
+#include <set>
+#include <vector>
+#include <random>
+#include <cassert>
+#include <structarnica/string_skip_list.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    StringSkipList urls;
+
+    //keys share long prefixes and differ in length
+    std::set<std::string> model;
+    std::mt19937 rng(3);
+
+    for (int i = 0; i < 5000; i++){
+        std::string url = "https://example.com/";
+        for (int len = rng() % 40; len--;)
+            url += char('a' + rng() % 4);
+        [[maybe_unused]] bool inserted = model.insert(url).second;
+        assert(urls.insert(url).second == inserted);
+    }
+
+    assert(urls.size() == model.size());
+
+    [[maybe_unused]] auto it = model.begin();
+    for ([[maybe_unused]] std::string_view key : urls)
+        assert(key == *it++);
+    assert(it == model.end());
+
+    //short keys and keys padded with zero bytes inside the prefix
+    std::string zero("ab\0", 3);
+    for (std::string_view key : {"", "a", "ab", "b", "abcdefgh", "abcdefghi", "abcdefg"})
+        urls.insert(key);
+    urls.insert(zero);
+
+    assert(urls.contains("") && urls.contains("ab") && urls.contains(zero));
+    assert(*urls.lower_bound("ab") == "ab");
+    assert(*urls.lower_bound(std::string_view("ab\x01", 3)) == "abcdefg");
+    assert(*urls.lower_bound("abcdefgh") == "abcdefgh");
+    assert(*urls.lower_bound("abcdefgha") == "abcdefghi");
+    assert(!urls.insert("abcdefg").second);
+
+    for (auto prev = urls.begin(), cur = std::next(urls.begin()); cur != urls.end(); ++prev, ++cur)
+        assert(*prev < *cur);
+
+    //lookups take string_view pieces of bigger buffer
+    std::string request = "GET https://example.com/ HTTP/1.1";
+    [[maybe_unused]] std::string_view path = std::string_view(request).substr(4, 20);
+    assert(urls.contains(path) == model.count(std::string(path)));
+
+    for ([[maybe_unused]] auto& key : model)
+        assert(urls.remove(key));
+    assert(!urls.remove("https://example.com/"));
+    assert(urls.size() == 8);
+
+    urls.clear();
+    assert(urls.empty() && urls.begin() == urls.end());
+
+    //real urls: scheme and often "www." are the same in most keys, cached
+    //bytes must come after them to decide anything
+    std::vector<std::string> hosts;
+    for (int i = 0; i < 500; i++){
+        std::string host = rng() % 2 ? "www." : "";
+        for (int len = 3 + rng() % 8; len--;)
+            host += char('a' + rng() % 26);
+        hosts.push_back(host + (rng() % 2 ? ".com" : ".org"));
+    }
+
+    const char* dirs[] = {"/", "/wiki/", "/user/", "/watch?v=", "/dp/", "/news/", "/r/", "/search?q="};
+    StringSkipList web;
+    std::set<std::string> web_model;
+
+    for (int i = 0; i < 20000; i++){
+        std::string url = "https://" + hosts[rng() % hosts.size()] + dirs[rng() % 8];
+        for (int len = 4 + rng() % 12; len--;)
+            url += char('a' + rng() % 26);
+        web.insert(url);
+        web_model.insert(url);
+    }
+    assert(web.size() == web_model.size() && web.common_prefix() == "https://");
+
+    size_t total = web.compares();
+    size_t decided = web.prefix_compares();
+    for ([[maybe_unused]] auto& url : web_model)
+        assert(web.contains(url));
+    assert(!web.contains("https://zzz.com/") && !web.contains("http://www.example.com/"));
+
+    //prefix alone decides most compares of lookups
+    total = web.compares() - total;
+    decided = web.prefix_compares() - decided;
+    assert(decided * 3 > total * 2);
+
+    //key out of common prefix shrinks it, order stays right
+    web.insert("http://www.example.com/");
+    web.insert("ftp://mirror/");
+    assert(web.common_prefix().empty() && *web.begin() == "ftp://mirror/");
+    assert(web.contains("http://www.example.com/") && web.contains(*web_model.begin()));
+    assert(std::equal(std::next(web.begin(), 2), web.end(), web_model.begin(), web_model.end()));
+
+    cout << "String skip list test passed" << endl;
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cassert>
+#include <structarnica/unrolled_skip_list.hpp>
+
+using namespace std;
+using namespace DS;
+
+int main() {
+
+    UnrolledSkipList<int> lst;
+
+    std::mt19937 rnd(7);
+    std::vector<int> model;
+
+    for (int i = 0; i < 50000; i++){
+        int v = rnd() % 20000;
+        lst.insert(v);
+        model.push_back(v);
+    }
+    std::sort(model.begin(), model.end());
+
+    assert(lst.size() == model.size());
+    assert(std::equal(lst.begin(), lst.end(), model.begin(), model.end()));
+    cout << "blocks: " << lst.blocks() << " capacity: " << UnrolledSkipList<int>::Capacity << '\n';
+    assert(lst.blocks() < model.size() / 8);
+
+    for (int v = 0; v < 20000; v += 37){
+        auto it = lst.lower_bound(v);
+        [[maybe_unused]] auto expected = std::lower_bound(model.begin(), model.end(), v);
+        assert((it == lst.end()) == (expected == model.end()));
+        if (it != lst.end())
+            assert(*it == *expected);
+        assert(lst.contains(v) == std::binary_search(model.begin(), model.end(), v));
+    }
+
+    //remove most keys so blocks are merged and dropped
+    for (int i = 0; i < 45000; i++){
+        int v = model[rnd() % model.size()];
+        assert(lst.remove(v));
+        model.erase(std::lower_bound(model.begin(), model.end(), v));
+    }
+    assert(!lst.remove(-1));
+
+    assert(lst.size() == model.size());
+    assert(std::equal(lst.begin(), lst.end(), model.begin(), model.end()));
+
+    [[maybe_unused]] auto last = lst.find(model.back());
+    assert(*last == model.back());
+    assert(*--last == model[model.size() - 2]);
+
+    for ([[maybe_unused]] int v : std::vector<int>(model))
+        assert(lst.remove(v));
+    assert(lst.empty() && lst.blocks() == 0);
+    assert(lst.begin() == lst.end());
+
+    UnrolledSkipList<uint64_t, 64> wide;
+    for (uint64_t i = 100000; i--;)
+        wide.insert(i * 3);
+    assert(std::is_sorted(wide.begin(), wide.end()));
+    assert(wide.contains(2997) && !wide.contains(2998));
+
+    return 0;
+}
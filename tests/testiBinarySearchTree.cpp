@@ -1,8 +1,11 @@
+#define DS_DEBUG_BST
 #include <structarnica/bst.hpp>
 #include <random>
 #include <functional>
 #include <vector>
 #include <iostream>
+#include <cassert>
+#include <algorithm>
 
 using namespace std;
 using namespace DS;
@@ -42,5 +45,215 @@ int main() {
     tree1.preorder(printer);
     std::cout << '\n';
 
+    //node handles move nodes between trees
+    BST<int> hot, cold;
+    for (int x : {8, 4, 12, 2, 6, 10, 14, 6})
+        hot.insert(x);
+
+    auto collect = [](auto& t){
+        std::vector<int> res;
+        t.inorder([&res](int a){ res.push_back(a); });
+        return res;
+    };
+
+    auto nh = hot.extract(8);
+    assert(nh && nh.value() == 8 && nh.count() == 1);
+    assert(!hot.extract(100));
+    assert((collect(hot) == std::vector<int>{2, 4, 6, 10, 12, 14}));
+
+    cold.insert(std::move(nh));
+    assert(!nh && (collect(cold) == std::vector<int>{8}));
+
+    //copies travel with the node
+    auto six = hot.extract(6);
+    assert(six.count() == 2);
+    cold.insert(6);
+    cold.insert(std::move(six));
+    cold.erase(6);
+    cold.erase(6);
+    assert((collect(cold) == std::vector<int>{6, 8}));
+
+    cold.merge(hot);
+    assert(collect(hot).empty());
+    assert((collect(cold) == std::vector<int>{2, 4, 6, 8, 10, 12, 14}));
+
+    //balancing policies keep height logarithmic for sequential keys
+    auto check = [](auto& tree){
+        const int n = 1 << 14;
+        for (int i = 0; i < n; i++)
+            tree.insert(i);
+        for (int i = 0; i < n; i += 2)
+            tree.insert(i);
+        assert(tree.height() <= 2 * 15);
+
+        //first erase drops a copy, second the node
+        for (int i = 0; i < n; i += 4){
+            tree.erase(i);
+            tree.erase(i);
+        }
+        for (int i = 1; i < n; i += 2)
+            tree.erase(i);
+        assert(tree.height() <= 2 * 14);
+
+        std::vector<int> res;
+        tree.inorder([&res](int a){ res.push_back(a); });
+        assert(res.size() == n / 4);
+        for (size_t i = 0; i < res.size(); i++)
+            assert(res[i] == int(4 * i + 2));
+
+        auto nh = tree.extract(6);
+        assert(nh && nh.count() == 2 && tree.height() <= 2 * 14);
+        tree.insert(std::move(nh));
+        tree.erase(6);
+        tree.erase(6);
+        tree.extract(6);
+
+        for (int i = 2; i < n; i += 4)
+            tree.erase(i), tree.erase(i);
+        assert(tree.height() == 0);
+    };
+
+    BST<int, std::less<int>, AVL> avl;
+    BST<int, std::less<int>, RedBlack> rb;
+    check(avl);
+    check(rb);
+
+    //invariants of the policy hold after every single change
+    auto invariants = [](auto& tree, unsigned seed){
+        std::mt19937 rnd(seed);
+        assert(tree.valid());
+
+        for (int i = 0; i < 4000; i++){
+            int x = rnd() % 500;
+
+            if (rnd() % 3){
+                tree.insert(x);
+            } else {
+                tree.erase(x);
+            }
+            assert(tree.valid());
+
+            if (i % 50 == 0){
+                auto nh = tree.extract(x);
+                assert(tree.valid());
+                if (nh)
+                    tree.insert(std::move(nh));
+                assert(tree.valid());
+            }
+        }
+
+        for (int x = 0; x < 500; x++){
+            tree.erase(x);
+            assert(tree.valid());
+        }
+    };
+
+    BST<int> plain_inv;
+    BST<int, std::less<int>, AVL> avl_inv;
+    BST<int, std::less<int>, RedBlack> rb_inv;
+    invariants(plain_inv, 1);
+    invariants(avl_inv, 2);
+    invariants(rb_inv, 3);
+    assert(plain_inv.valid() && avl_inv.valid() && rb_inv.valid());
+
+    //random load and merge of balanced trees
+    std::mt19937 gen(7);
+    BST<int, std::less<int>, RedBlack> left;
+    BST<int, std::less<int>, RedBlack> right;
+    for (int i = 0; i < 5000; i++){
+        left.insert(gen() % 3000);
+        right.insert(gen() % 3000);
+    }
+    for (int i = 0; i < 2000; i++)
+        left.erase(gen() % 3000);
+    left.merge(right);
+    assert(collect(right).empty() && left.height() <= 2 * 12 && left.valid());
+    auto all = collect(left);
+    assert(std::is_sorted(all.begin(), all.end()) && std::adjacent_find(all.begin(), all.end()) == all.end());
+
+    //order statistics follow every change of shape
+    auto stats = [&gen](auto& tree){
+        std::vector<int> ref;
+        for (int i = 0; i < 3000; i++){
+            int x = gen() % 1000;
+            tree.insert(x);
+            ref.push_back(x);
+        }
+        for (int i = 0; i < 1500; i++){
+            int x = gen() % 1000;
+            auto it = std::find(ref.begin(), ref.end(), x);
+            tree.erase(x);
+            if (it != ref.end())
+                ref.erase(it);
+        }
+
+        auto nh = tree.extract(ref[0]);
+        [[maybe_unused]] long moved = nh.count();
+        [[maybe_unused]] int key = nh.value();
+        tree.insert(std::move(nh));
+        assert(long(std::count(ref.begin(), ref.end(), key)) == moved);
+
+        std::sort(ref.begin(), ref.end());
+        assert(tree.size() == ref.size());
+
+        for (size_t k = 0; k < ref.size(); k += 7)
+            assert(tree.select(k) == ref[k]);
+        for (int x = -1; x <= 1000; x += 3){
+            assert(tree.rank(x) == size_t(std::lower_bound(ref.begin(), ref.end(), x) - ref.begin()));
+            assert(tree.count_range(x, x + 100) == size_t(std::lower_bound(ref.begin(), ref.end(), x + 100) - std::lower_bound(ref.begin(), ref.end(), x)));
+        }
+        assert(tree.count_range(500, 100) == 0);
+
+        [[maybe_unused]] bool thrown = false;
+        try {
+            tree.select(ref.size());
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    };
+
+    BST<int> os_plain;
+    BST<int, std::less<int>, AVL> os_avl;
+    BST<int, std::less<int>, RedBlack> os_rb;
+    stats(os_plain);
+    stats(os_avl);
+    stats(os_rb);
+
+    //deletion by copying keeps counts of subtrees
+    BST<int> copied;
+    std::vector<int> copied_ref;
+    for (int i = 0; i < 3000; i++){
+        int x = gen() % 1000;
+        copied.insert(x);
+        copied_ref.push_back(x);
+    }
+    for (int i = 0; i < 2000; i++){
+        int x = gen() % 1000;
+        auto it = std::find(copied_ref.begin(), copied_ref.end(), x);
+        copied.erase_copy(x);
+        if (it != copied_ref.end())
+            copied_ref.erase(it);
+        assert(copied.size() == copied_ref.size());
+    }
+
+    std::sort(copied_ref.begin(), copied_ref.end());
+    auto distinct = copied_ref;
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    assert(copied.valid() && collect(copied) == distinct);
+    for (size_t k = 0; k < copied_ref.size(); k += 5)
+        assert(copied.select(k) == copied_ref[k] && copied.rank(copied_ref[k]) == size_t(std::lower_bound(copied_ref.begin(), copied_ref.end(), copied_ref[k]) - copied_ref.begin()));
+
+    //rebuilt tree keeps its counts
+    size_t before = os_plain.size();
+    [[maybe_unused]] int median = os_plain.select(before / 2);
+    os_plain.balance();
+    assert(os_plain.size() == before && os_plain.select(before / 2) == median);
+    os_plain.transform_to_list();
+    assert(os_plain.size() == before && os_plain.select(before / 2) == median);
+
+    os_plain.clear();
+    assert(os_plain.empty() && os_plain.size() == 0 && os_plain.rank(5) == 0);
+
     return 0;
 }